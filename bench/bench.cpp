@@ -0,0 +1,545 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "adjacency_graph.h"
+#include "binary_graph_format.h"
+#include "compressed_sparse_row_graph.h"
+#include "delta_compressed_graph.h"
+#include "depth_first_search_algorithm.h"
+#include "edge_list_reader.h"
+#include "forward_backward_strongly_connected_component_algorithm.h"
+#include "graph_generators.h"
+#include "mapped_graph.h"
+#include "pearce_strongly_connected_component_algorithm.h"
+#include "performance_counters.h"
+#include "semi_external_strongly_connected_component_algorithm.h"
+#include "strongly_connected_component_algorithm.h"
+#include "vertex_reordering.h"
+
+namespace
+{
+    using Vertex = uint32_t;
+    using BenchEdge = Graph::Edge<Vertex>;
+    using BenchGraph = Graph::CompressedSparseRowGraph<Vertex, BenchEdge>;
+    using BenchAdjacencyGraph = Graph::AdjacencyGraph<Vertex, BenchEdge>;
+    using BenchPooledGraph = Graph::AdjacencyGraph<Vertex, BenchEdge,
+        Graph::PoolContainerPolicy>;
+    using BenchTarjan = Graph::StronglyConnectedComponentAlgorithm<BenchGraph>;
+    using BenchFlatGraph = Graph::AdjacencyGraph<Vertex, BenchEdge,
+        Graph::FlatContainerPolicy>;
+    using BenchReordering = Graph::VertexReordering<BenchGraph, Vertex>;
+    using BenchCompressedGraph = Graph::DeltaCompressedGraph<Vertex, BenchEdge>;
+
+    struct Options
+    {
+        std::vector<std::string> families;
+        std::vector<size_t> edgeCounts;
+        size_t threadCount;
+        size_t maxAdjacencyEdges;
+        std::string tempDirectory;
+        uint64_t seed;
+    };
+
+    struct Workload
+    {
+        size_t vertexCount;
+        std::vector<BenchEdge> edges;
+    };
+
+    // Per-run figures that are not phase timings
+    struct RunTotals
+    {
+        size_t componentsCount;
+        size_t compressedBytes;
+        uint64_t semiExternalBytesRead;
+        size_t semiExternalPasses;
+    };
+
+    struct Phase
+    {
+        std::string name;
+        double seconds;
+        size_t edges;
+        Graph::PerformanceCounts counts;
+    };
+
+    // Peak resident set of the whole process so far, in bytes
+    size_t PeakResidentBytes()
+    {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;
+    }
+
+    template <typename TFunc>
+    double Time(TFunc func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // A single path: the deepest possible DFS
+    Workload MakeChain(size_t edgeCount)
+    {
+        Workload workload{ edgeCount + 1, {} };
+        workload.edges.reserve(edgeCount);
+        for (size_t vertex = 0; vertex < edgeCount; ++vertex)
+        {
+            workload.edges.emplace_back(Vertex(vertex), Vertex(vertex + 1));
+        }
+        return workload;
+    }
+
+    // Square grid with edges to the right and down: a DAG with long paths
+    Workload MakeGrid(size_t edgeCount)
+    {
+        size_t side = std::max<size_t>(2, static_cast<size_t>(std::sqrt(edgeCount / 2.0)) + 1);
+        Workload workload{ side * side, {} };
+        workload.edges.reserve(2 * side * (side - 1));
+        for (size_t row = 0; row < side; ++row)
+        {
+            for (size_t column = 0; column < side; ++column)
+            {
+                Vertex vertex = Vertex(row * side + column);
+                if (column + 1 < side)
+                {
+                    workload.edges.emplace_back(vertex, vertex + 1);
+                }
+                if (row + 1 < side)
+                {
+                    workload.edges.emplace_back(vertex, Vertex(vertex + side));
+                }
+            }
+        }
+        return workload;
+    }
+
+    Workload FromGenerated(Graph::GeneratedGraph<Vertex>&& generated)
+    {
+        return Workload{ generated.vertexCount, std::move(generated.edges) };
+    }
+
+    Workload MakeWorkload(const std::string& family, size_t edgeCount,
+        const Options& options)
+    {
+        Graph::GraphGenerator<Vertex> generator(options.seed, options.threadCount);
+        if (family == "chain")
+        {
+            return MakeChain(edgeCount);
+        }
+        if (family == "grid")
+        {
+            return MakeGrid(edgeCount);
+        }
+        // One component holding everything
+        if (family == "giant")
+        {
+            size_t vertexCount = std::max<size_t>(2, edgeCount / 4);
+            return FromGenerated(generator.PlantedComponents(
+                1, vertexCount, edgeCount - vertexCount, 0));
+        }
+        // Triangles linked by forward edges
+        if (family == "tiny")
+        {
+            size_t componentCount = std::max<size_t>(1, edgeCount / 4);
+            return FromGenerated(generator.PlantedComponents(
+                componentCount, 3, 0, edgeCount - 3 * componentCount));
+        }
+        // 16 edges per vertex, as in Graph500
+        if (family == "rmat")
+        {
+            size_t scale = 1;
+            while ((size_t(16) << scale) < edgeCount)
+            {
+                ++scale;
+            }
+            return FromGenerated(generator.Rmat(scale, edgeCount));
+        }
+        if (family == "powerlaw")
+        {
+            return FromGenerated(generator.PowerLaw(
+                std::max<size_t>(1, edgeCount / 8), edgeCount));
+        }
+        if (family == "random")
+        {
+            return FromGenerated(generator.ErdosRenyi(
+                std::max<size_t>(1, edgeCount / 8), edgeCount));
+        }
+        if (family == "dag")
+        {
+            size_t layerWidth = std::max<size_t>(1,
+                static_cast<size_t>(std::sqrt(edgeCount / 8.0)));
+            return FromGenerated(generator.LayeredDag(
+                std::max<size_t>(2, edgeCount / 8 / layerWidth), layerWidth, edgeCount));
+        }
+        throw std::runtime_error("unknown graph family '" + family + "'");
+    }
+
+    void WriteEdgeList(const Workload& workload, const std::string& path)
+    {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (file == nullptr)
+        {
+            throw std::runtime_error("cannot create '" + path + "'");
+        }
+        for (const auto& edge : workload.edges)
+        {
+            std::fprintf(file, "%u %u\n", edge.Source(), edge.Target());
+        }
+        std::fclose(file);
+    }
+
+    std::vector<Phase> RunWorkload(const Options& options, const std::string& family,
+        const Workload& workload, Graph::PerformanceCounters& counters,
+        RunTotals& totals)
+    {
+        std::vector<Phase> phases;
+        size_t edgeCount = workload.edges.size();
+        auto record = [&phases, &counters, edgeCount](const std::string& name,
+            const std::function<void()>& func)
+        {
+            counters.Reset();
+            counters.Start();
+            double seconds = Time(func);
+            counters.Stop();
+            phases.push_back(Phase{ name, seconds, edgeCount, counters.Get() });
+        };
+
+        BenchGraph graph;
+        record("build_csr", [&]()
+        {
+            graph = BenchGraph(workload.vertexCount, workload.edges.begin(), workload.edges.end());
+        });
+
+        record("dfs_csr", [&]()
+        {
+            Graph::DepthFirstSearchAlgorithm<BenchGraph, Graph::VectorPropertyMapSelector,
+                Graph::DepthFirstSearchVisitor> dfs(graph);
+            dfs.Compute();
+        });
+
+        record("scc_tarjan_csr", [&]()
+        {
+            Graph::StronglyConnectedComponentAlgorithm<BenchGraph> algo(graph);
+            algo.Compute();
+            totals.componentsCount = algo.GetComponentsCount();
+        });
+
+        // Warm workspace, as when recomputing over many graphs in a loop
+        BenchTarjan::TWorkspace workspace;
+        BenchTarjan(graph, workspace).Compute();
+        record("scc_tarjan_csr_workspace", [&]()
+        {
+            BenchTarjan algo(graph, workspace);
+            algo.Compute();
+        });
+
+        BenchCompressedGraph compressedGraph;
+        record("build_compressed", [&]() { compressedGraph = BenchCompressedGraph(graph); });
+        totals.compressedBytes = compressedGraph.ByteSize();
+        record("scc_tarjan_compressed", [&]()
+        {
+            Graph::StronglyConnectedComponentAlgorithm<BenchCompressedGraph> algo(
+                compressedGraph);
+            algo.Compute();
+        });
+        compressedGraph = BenchCompressedGraph();
+
+        // Same search on relabeled copies; compare llc_misses_per_edge with
+        // scc_tarjan_csr
+        for (int index = Graph::BFS_ORDER; index < Graph::VERTEX_ORDER_COUNT; ++index)
+        {
+            auto order = static_cast<Graph::VertexOrder>(index);
+            std::string name = Graph::VertexOrderName(order);
+            std::unique_ptr<BenchReordering> reordering;
+            record("reorder_" + name, [&]()
+            {
+                reordering.reset(new BenchReordering(graph, order));
+            });
+            record("scc_tarjan_csr_" + name, [&]()
+            {
+                Graph::StronglyConnectedComponentAlgorithm<BenchReordering::TCompactGraph> algo(
+                    reordering->GetGraph());
+                algo.Compute();
+            });
+        }
+
+        record("scc_tarjan_trim_csr", [&]()
+        {
+            Graph::StronglyConnectedComponentAlgorithm<BenchGraph> algo(graph);
+            algo.SetTrimming(true, options.threadCount);
+            algo.Compute();
+        });
+
+        record("scc_pearce_csr", [&]()
+        {
+            Graph::PearceStronglyConnectedComponentAlgorithm<BenchGraph> algo(graph);
+            algo.Compute();
+        });
+
+        record("scc_forward_backward_csr", [&]()
+        {
+            Graph::ForwardBackwardStronglyConnectedComponentAlgorithm<BenchGraph> algo(
+                graph, options.threadCount);
+            algo.Compute();
+        });
+
+        std::string basePath = options.tempDirectory + "/scc_bench_" + family;
+        std::string textPath = basePath + ".txt";
+        std::string binaryPath = basePath + ".bin";
+        WriteEdgeList(workload, textPath);
+        record("ingest_text", [&]()
+        {
+            auto parsed = Graph::ReadEdgeList<Vertex>(textPath, options.threadCount);
+            if (parsed.EdgeCount() != edgeCount)
+            {
+                throw std::runtime_error("edge list round trip lost edges");
+            }
+        });
+        std::remove(textPath.c_str());
+
+        record("write_binary", [&]() { Graph::WriteBinaryGraph(graph, binaryPath); });
+        record("scc_tarjan_mapped", [&]()
+        {
+            Graph::MappedGraph<Vertex, BenchEdge> mapped(binaryPath);
+            Graph::StronglyConnectedComponentAlgorithm<decltype(mapped)> algo(mapped);
+            algo.Compute();
+        });
+        // Per-vertex state plus room for a quarter of the targets, so the
+        // file is streamed until most of the graph is settled
+        record("scc_semi_external", [&]()
+        {
+            size_t budget = workload.vertexCount * (sizeof(Vertex) + sizeof(size_t)) +
+                2 * Graph::SemiExternalStronglyConnectedComponentAlgorithm<
+                    Vertex>::kDefaultBlockBytes + edgeCount * sizeof(Vertex) / 4;
+            Graph::SemiExternalStronglyConnectedComponentAlgorithm<Vertex> algo(
+                binaryPath, budget);
+            algo.Compute();
+            totals.semiExternalBytesRead = algo.GetBytesRead();
+            totals.semiExternalPasses = algo.GetPassCount();
+        });
+        std::remove(binaryPath.c_str());
+
+        if (edgeCount <= options.maxAdjacencyEdges)
+        {
+            BenchAdjacencyGraph adjacencyGraph(true);
+            record("build_adjacency", [&]()
+            {
+                adjacencyGraph.AddVerticesAndEdgeRange(
+                    workload.edges.begin(), workload.edges.end());
+            });
+            record("scc_tarjan_adjacency", [&]()
+            {
+                Graph::StronglyConnectedComponentAlgorithm<BenchAdjacencyGraph> algo(
+                    adjacencyGraph);
+                algo.Compute();
+            });
+            record("destroy_adjacency", [&]() { adjacencyGraph = BenchAdjacencyGraph(); });
+
+            // Vector out-edges, open-addressing vertex table and result maps
+            BenchFlatGraph flatGraph(true);
+            record("build_adjacency_flat", [&]()
+            {
+                flatGraph.AddVerticesAndEdgeRange(workload.edges.begin(), workload.edges.end());
+            });
+            record("scc_tarjan_adjacency_flat", [&]()
+            {
+                Graph::StronglyConnectedComponentAlgorithm<BenchFlatGraph> algo(flatGraph);
+                algo.Compute();
+            });
+            record("destroy_adjacency_flat", [&]() { flatGraph = BenchFlatGraph(); });
+
+            // Same graph and result maps with nodes carved from one pool
+            Graph::NodePool pool;
+            {
+                Graph::NodePool::Scope scope(pool);
+                BenchPooledGraph pooledGraph(true);
+                record("build_adjacency_pool", [&]()
+                {
+                    pooledGraph.AddVerticesAndEdgeRange(
+                        workload.edges.begin(), workload.edges.end());
+                });
+                record("scc_tarjan_adjacency_pool", [&]()
+                {
+                    Graph::StronglyConnectedComponentAlgorithm<BenchPooledGraph> algo(
+                        pooledGraph);
+                    algo.Compute();
+                });
+                record("destroy_adjacency_pool", [&]()
+                {
+                    pooledGraph = BenchPooledGraph();
+                    pool.Release();
+                });
+            }
+        }
+        return phases;
+    }
+
+    // Unavailable counters are left out; misses are also given per edge so
+    // runs of different sizes compare directly
+    void PrintCounts(std::ostream& out, const Graph::PerformanceCounts& counts, size_t edges)
+    {
+        for (int index = 0; index < Graph::PERFORMANCE_EVENT_COUNT; ++index)
+        {
+            auto event = static_cast<Graph::PerformanceEvent>(index);
+            if (!counts.available[event])
+            {
+                continue;
+            }
+            out << ", \"" << Graph::PerformanceEventName(event) << "\": " << counts.values[event];
+            if (event != Graph::CYCLES && event != Graph::INSTRUCTIONS && edges > 0)
+            {
+                out << ", \"" << Graph::PerformanceEventName(event) << "_per_edge\": "
+                    << static_cast<double>(counts.values[event]) / edges;
+            }
+        }
+    }
+
+    void PrintUsage()
+    {
+        std::cerr <<
+            "usage: bench [--family chain|giant|tiny|rmat|powerlaw|random|dag|grid]...\n"
+            "             [--edges N]...\n"
+            "             [--threads N] [--max-adjacency-edges N] [--tmp DIR] [--seed N]\n"
+            "Prints one JSON document with per-phase times for every family and size,\n"
+            "plus hardware counters where perf_event_open allows them.\n";
+    }
+
+    Options ParseOptions(int argc, char* argv[])
+    {
+        Options options{ {}, {}, 0, 10000000, "/tmp", 1 };
+        for (int index = 1; index < argc; ++index)
+        {
+            std::string option = argv[index];
+            if (option == "--help" || index + 1 == argc)
+            {
+                PrintUsage();
+                std::exit(option == "--help" ? 0 : 2);
+            }
+            std::string value = argv[++index];
+            if (option == "--family")
+            {
+                options.families.push_back(value);
+            }
+            else if (option == "--edges")
+            {
+                options.edgeCounts.push_back(static_cast<size_t>(std::stod(value)));
+            }
+            else if (option == "--threads")
+            {
+                options.threadCount = std::stoul(value);
+            }
+            else if (option == "--max-adjacency-edges")
+            {
+                options.maxAdjacencyEdges = static_cast<size_t>(std::stod(value));
+            }
+            else if (option == "--tmp")
+            {
+                options.tempDirectory = value;
+            }
+            else if (option == "--seed")
+            {
+                options.seed = std::stoull(value);
+            }
+            else
+            {
+                PrintUsage();
+                std::exit(2);
+            }
+        }
+        if (options.families.empty())
+        {
+            options.families = {
+                "chain", "giant", "tiny", "rmat", "powerlaw", "random", "dag", "grid" };
+        }
+        if (options.edgeCounts.empty())
+        {
+            options.edgeCounts = { 100000, 1000000 };
+        }
+        return options;
+    }
+
+    void Run(const Options& options)
+    {
+        std::ostream& out = std::cout;
+        Graph::PerformanceCounters counters;
+        out << "{\n  \"threads\": " << options.threadCount
+            << ",\n  \"counters_available\": " << (counters.IsAnyAvailable() ? "true" : "false")
+            << ",\n  \"seed\": " << options.seed
+            << ",\n  \"runs\": [";
+        bool firstRun = true;
+        for (const auto& family : options.families)
+        {
+            for (auto requestedEdges : options.edgeCounts)
+            {
+                Workload workload;
+                double generateSeconds = Time([&]()
+                {
+                    workload = MakeWorkload(family, requestedEdges, options);
+                });
+                RunTotals totals{ 0, 0, 0, 0 };
+                auto phases = RunWorkload(options, family, workload, counters, totals);
+
+                out << (firstRun ? "\n" : ",\n") << "    {\n"
+                    << "      \"family\": \"" << family << "\",\n"
+                    << "      \"vertices\": " << workload.vertexCount << ",\n"
+                    << "      \"edges\": " << workload.edges.size() << ",\n"
+                    << "      \"components\": " << totals.componentsCount << ",\n"
+                    << "      \"compressed_bytes_per_edge\": "
+                    << (workload.edges.empty() ? 0.0 :
+                        static_cast<double>(totals.compressedBytes) / workload.edges.size())
+                    << ",\n"
+                    << "      \"semi_external_bytes_read\": " << totals.semiExternalBytesRead
+                    << ",\n"
+                    << "      \"semi_external_passes\": " << totals.semiExternalPasses << ",\n"
+                    << "      \"generate_seconds\": " << generateSeconds << ",\n"
+                    << "      \"peak_rss_bytes\": " << PeakResidentBytes() << ",\n"
+                    << "      \"phases\": [";
+                for (size_t index = 0; index < phases.size(); ++index)
+                {
+                    const auto& phase = phases[index];
+                    out << (index == 0 ? "\n" : ",\n")
+                        << "        { \"name\": \"" << phase.name << "\", \"seconds\": "
+                        << phase.seconds << ", \"edges_per_second\": "
+                        << (phase.seconds > 0 ? phase.edges / phase.seconds : 0.0);
+                    PrintCounts(out, phase.counts, phase.edges);
+                    out << " }";
+                }
+                out << "\n      ]\n    }";
+                out.flush();
+                firstRun = false;
+            }
+        }
+        out << "\n  ]\n}\n";
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        Run(ParseOptions(argc, argv));
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
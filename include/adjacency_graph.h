@@ -1,22 +1,48 @@
 #ifndef STRONGLY_CONNECTED_COMPONENTS_ADJACENCY_GRAPH_H_
 #define STRONGLY_CONNECTED_COMPONENTS_ADJACENCY_GRAPH_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
 #include "iterator_tools.h"
 #include "graph_containers.h"
+#include "property_map.h"
+#include "flat_hash_map.h"
 #include "edge.h"
+#include "vertex_action.h"
+#include "edge_action.h"
 
 namespace Graph
 {
-    template <typename VertexDescriptor, typename Edge>
+    // The container policy sets the layout of the vertex table and the
+    // out-edge lists, and is the default for algorithms run on the graph.
+    // With PoolContainerPolicy every node comes from the NodePool whose
+    // scope is open when the graph is constructed; with FlatContainerPolicy
+    // out-edges are vectors and the membership index is off.
+    template <typename VertexDescriptor, typename Edge,
+        typename TContainerPolicy = StandardContainerPolicy>
     class AdjacencyGraph
     {
     public:
         using TVertexDescriptor = VertexDescriptor;
         using TEdge = Edge;
+        using TEdgeList = typename TContainerPolicy::template EdgeList<TEdge>;
+        using TVertexTable = typename TContainerPolicy::template Dictionary<
+            TVertexDescriptor, TEdgeList>;
+
+        using ConstVertexIterator = KeyIterator<typename TVertexTable::const_iterator>;
+        using ConstEdgeIterator = typename TEdgeList::const_iterator;
 
-        using ConstVertexIterator = KeyIterator < typename Dictionary < TVertexDescriptor,
-            List<TEdge >> ::const_iterator>;
-        using ConstEdgeIterator = typename List<TEdge>::const_iterator;
+        // Vertices with at least this many out-edges get a hash index of their
+        // targets, making ContainsEdge, RemoveEdge and the duplicate check in
+        // AddEdge O(1) expected instead of a list walk. Only node lists can
+        // be indexed, as the index keeps iterators into them.
+        static constexpr size_t kDefaultMembershipIndexThreshold = 32;
+        static constexpr size_t kNoMembershipIndex = std::numeric_limits<size_t>::max();
 
         AdjacencyGraph()
             : AdjacencyGraph(false)
@@ -26,8 +52,146 @@ namespace Graph
             : allowParallelEdges_(allowParallelEdges)
             , vertexEdges_()
             , edgeCount_(0)
+            , vertexAddedAction_()
+            , edgeAddedAction_()
+            , vertexRemovedAction_()
+            , edgeRemovedAction_()
+            , membershipIndexThreshold_(kDefaultMembershipIndexThreshold)
+            , membershipIndices_()
         {}
 
+        // Copies share no observers; indices are rebuilt since they point
+        // into the edge lists
+        AdjacencyGraph(const AdjacencyGraph& other)
+            : allowParallelEdges_(other.allowParallelEdges_)
+            , vertexEdges_(other.vertexEdges_)
+            , edgeCount_(other.edgeCount_)
+            , vertexAddedAction_()
+            , edgeAddedAction_()
+            , vertexRemovedAction_()
+            , edgeRemovedAction_()
+            , membershipIndexThreshold_(other.membershipIndexThreshold_)
+            , membershipIndices_()
+        {
+            RebuildMembershipIndices();
+        }
+
+        // Observers stay behind as well: they belong to the other graph,
+        // which is left empty without notifying them
+        AdjacencyGraph(AdjacencyGraph&& other)
+            : allowParallelEdges_(other.allowParallelEdges_)
+            , vertexEdges_(std::move(other.vertexEdges_))
+            , edgeCount_(other.edgeCount_)
+            , vertexAddedAction_()
+            , edgeAddedAction_()
+            , vertexRemovedAction_()
+            , edgeRemovedAction_()
+            , membershipIndexThreshold_(other.membershipIndexThreshold_)
+            , membershipIndices_()
+        {
+            RebuildMembershipIndices();
+            other.vertexEdges_.clear();
+            other.edgeCount_ = 0;
+            other.membershipIndices_.clear();
+        }
+
+        // Assignment keeps this graph's observers: they see every old edge
+        // and vertex removed, as in Clear(), then every new vertex and edge
+        // added
+        AdjacencyGraph& operator=(const AdjacencyGraph& other)
+        {
+            if (this != &other)
+            {
+                Clear();
+                allowParallelEdges_ = other.allowParallelEdges_;
+                vertexEdges_ = other.vertexEdges_;
+                edgeCount_ = other.edgeCount_;
+                membershipIndexThreshold_ = other.membershipIndexThreshold_;
+                RebuildMembershipIndices();
+                NotifyAdded();
+            }
+            return *this;
+        }
+
+        // The moved-from graph is left empty and keeps its own observers,
+        // which are not notified
+        AdjacencyGraph& operator=(AdjacencyGraph&& other)
+        {
+            if (this != &other)
+            {
+                Clear();
+                allowParallelEdges_ = other.allowParallelEdges_;
+                vertexEdges_ = std::move(other.vertexEdges_);
+                edgeCount_ = other.edgeCount_;
+                membershipIndexThreshold_ = other.membershipIndexThreshold_;
+                RebuildMembershipIndices();
+                other.vertexEdges_.clear();
+                other.edgeCount_ = 0;
+                other.membershipIndices_.clear();
+                NotifyAdded();
+            }
+            return *this;
+        }
+
+        // kNoMembershipIndex turns the index off
+        void SetMembershipIndexThreshold(size_t degree)
+        {
+            membershipIndexThreshold_ = std::max<size_t>(1, degree);
+            RebuildMembershipIndices();
+        }
+
+        size_t GetMembershipIndexThreshold() const
+        {
+            return membershipIndexThreshold_;
+        }
+
+        // Observers are notified after a vertex or an edge has actually been
+        // inserted or removed; rejected duplicates are not reported. Removing
+        // a vertex reports each of its incident edges before the vertex.
+        template <typename TFunc>
+        void SetVertexAddedAction(TFunc action)
+        {
+            vertexAddedAction_ = VertexAction<TVertexDescriptor>(action);
+        }
+
+        void ResetVertexAddedAction()
+        {
+            vertexAddedAction_ = VertexAction<TVertexDescriptor>();
+        }
+
+        template <typename TFunc>
+        void SetEdgeAddedAction(TFunc action)
+        {
+            edgeAddedAction_ = EdgeAction<TVertexDescriptor, TEdge>(action);
+        }
+
+        void ResetEdgeAddedAction()
+        {
+            edgeAddedAction_ = EdgeAction<TVertexDescriptor, TEdge>();
+        }
+
+        template <typename TFunc>
+        void SetVertexRemovedAction(TFunc action)
+        {
+            vertexRemovedAction_ = VertexAction<TVertexDescriptor>(action);
+        }
+
+        void ResetVertexRemovedAction()
+        {
+            vertexRemovedAction_ = VertexAction<TVertexDescriptor>();
+        }
+
+        template <typename TFunc>
+        void SetEdgeRemovedAction(TFunc action)
+        {
+            edgeRemovedAction_ = EdgeAction<TVertexDescriptor, TEdge>(action);
+        }
+
+        void ResetEdgeRemovedAction()
+        {
+            edgeRemovedAction_ = EdgeAction<TVertexDescriptor, TEdge>();
+        }
+
         bool IsDirected() const
         {
             return true;
@@ -111,6 +275,11 @@ namespace Graph
         bool ContainsEdge(const TVertexDescriptor& source,
             const TVertexDescriptor& target) const
         {
+            auto iindex = membershipIndices_.find(source);
+            if (iindex != membershipIndices_.end())
+            {
+                return iindex->second.Contains(target);
+            }
             IteratorRange<ConstEdgeIterator> range;
             if (!TryGetEdges(source, range))
             {
@@ -154,7 +323,8 @@ namespace Graph
             {
                 return false;
             }
-            vertexEdges_[vertex] = List<TEdge>();
+            EdgesOf(vertex);
+            vertexAddedAction_(vertex);
             return true;
         }
 
@@ -188,8 +358,7 @@ namespace Graph
                     {
                         if (iedge->Target() == vertex)
                         {
-                            iedge = edges.erase(iedge);
-                            --edgeCount_;
+                            iedge = EraseEdge(edges, iedge);
                         }
                         else
                         {
@@ -197,29 +366,32 @@ namespace Graph
                         }
                     }
                 }
-                else
-                {
-                    auto& edges = vertexEdges_[vertex];
-                    edgeCount_ -= edges.size();
-                    edges.clear();
-                }
             }
+            // vertex may refer to the key that is about to be erased
+            TVertexDescriptor removed = vertex;
+            ClearOutEdges(removed);
+            vertexEdges_.erase(removed);
+            membershipIndices_.erase(removed);
+            vertexRemovedAction_(removed);
             return true;
         }
 
         template <typename Predicate>
         size_t RemoveVertexIf(Predicate pred)
         {
-            size_t count = 0;
+            List<TVertexDescriptor> toRemove;
             for (const auto& vertex : Vertices())
             {
                 if (pred(vertex))
                 {
-                    RemoveVertex(vertex);
-                    ++count;
+                    toRemove.push_back(vertex);
                 }
             }
-            return count;
+            for (const auto& vertex : toRemove)
+            {
+                RemoveVertex(vertex);
+            }
+            return toRemove.size();
         }
 
         bool AddVerticesAndEdge(const TEdge& edge)
@@ -232,15 +404,7 @@ namespace Graph
         template <typename TIterator>
         size_t AddVerticesAndEdgeRange(TIterator begin, TIterator end)
         {
-            size_t count = 0;
-            for (auto iedge = begin; iedge != end; ++iedge)
-            {
-                if (AddVerticesAndEdge(*iedge))
-                {
-                    ++count;
-                }
-            }
-            return count;
+            return AddEdges(begin, end, true);
         }
 
         bool AddEdge(const TEdge& edge)
@@ -252,37 +416,41 @@ namespace Graph
                     return false;
                 }
             }
-            vertexEdges_[edge.Source()].push_back(edge);
+            AppendEdge(EdgesOf(edge.Source()), edge);
             ++edgeCount_;
+            edgeAddedAction_(edge);
             return true;
         }
 
         template <typename TIterator>
         size_t AddEdgeRange(TIterator begin, TIterator end)
         {
-            size_t count = 0;
-            for (auto iedge = begin; iedge != end; ++iedge)
-            {
-                if (AddEdge(*iedge))
-                {
-                    ++count;
-                }
-            }
-            return count;
+            return AddEdges(begin, end, false);
         }
 
         bool RemoveEdge(const TEdge& edge)
         {
-            if (ContainsVertex(edge.Source()))
+            auto iList = vertexEdges_.find(edge.Source());
+            if (iList != vertexEdges_.end())
             {
-                auto& edges = vertexEdges_[edge.Source()];
+                auto& edges = iList->second;
+                auto iindex = membershipIndices_.find(edge.Source());
+                if (iindex != membershipIndices_.end())
+                {
+                    auto* entry = iindex->second.Find(edge.Target());
+                    if (entry == nullptr)
+                    {
+                        return false;
+                    }
+                    EraseEdge(edges, entry->first);
+                    return true;
+                }
                 for (auto iedge = edges.begin(); iedge != edges.end(); ++iedge)
                 {
                     if (iedge->Source() == edge.Source() &&
                         iedge->Target() == edge.Target())
                     {
-                        edges.erase(iedge);
-                        --edgeCount_;
+                        EraseEdge(edges, iedge);
                         return true;
                     }
                 }
@@ -296,56 +464,310 @@ namespace Graph
             size_t count = 0;
             for (auto& vertexEdgesPair : vertexEdges_)
             {
-                for (auto& edge : vertexEdgesPair->second)
-                {
-                    if (pred(edge))
-                    {
-                        if (RemoveEdge(edge))
-                        {
-                            ++count;
-                        }
-                    }
-                }
+                count += RemoveOutEdgesIf(vertexEdgesPair.first, pred);
             }
             return count;
         }
 
         void ClearOutEdges(const TVertexDescriptor& vertex)
         {
-            auto& edges = vertexEdges_[vertex];
-            size_t toDelete = edges.size();
-            edges.clear();
-            edgeCount_ -= toDelete;
+            auto& edges = EdgesOf(vertex);
+            while (!edges.empty())
+            {
+                EraseEdge(edges, edges.begin());
+            }
         }
 
         template <typename Predicate>
         size_t RemoveOutEdgesIf(const TVertexDescriptor& vertex, Predicate pred)
         {
             size_t count = 0;
-            auto& edges = vertexEdges_[vertex];
-            for (auto& edge : edges)
+            auto& edges = EdgesOf(vertex);
+            for (auto iedge = edges.begin(); iedge != edges.end();)
             {
-                if (pred(edge))
+                if (pred(*iedge))
                 {
-                    if (RemoveEdge(edge))
-                    {
-                        ++count;
-                    }
+                    iedge = EraseEdge(edges, iedge);
+                    ++count;
+                }
+                else
+                {
+                    ++iedge;
                 }
             }
             return count;
         }
 
+        // Without removal observers the tables are dropped wholesale; with a
+        // pool that returns every node to its free list without a free call
         void Clear()
         {
-            vertexEdges_.clear();
+            if (!vertexRemovedAction_ && !edgeRemovedAction_)
+            {
+                membershipIndices_.clear();
+                vertexEdges_.clear();
+                edgeCount_ = 0;
+                return;
+            }
+            for (auto& vertexEdgesPair : vertexEdges_)
+            {
+                auto& edges = vertexEdgesPair.second;
+                while (!edges.empty())
+                {
+                    EraseEdge(edges, edges.begin());
+                }
+            }
+            std::vector<TVertexDescriptor> vertices(Vertices().begin(), Vertices().end());
+            for (const auto& vertex : vertices)
+            {
+                vertexEdges_.erase(vertex);
+                vertexRemovedAction_(vertex);
+            }
+            membershipIndices_.clear();
             edgeCount_ = 0;
         }
+
+    private:
+        // Out-degrees up to which a list scan beats building a hash set
+        static constexpr size_t kDeduplicationScanLimit = 16;
+
+        // Range insertion groups the edges by source: a counting sort over
+        // one slot per distinct source, then each source's edge list is
+        // looked up once and its edges appended together. Duplicates are
+        // rejected by scanning short lists, and otherwise through a hash set
+        // of that source's targets, seeded from its existing out-edges and
+        // dropped when the next source starts. Expected O(E) plus the
+        // touched out-degrees; besides a copy of the range, the extra memory
+        // is two indices per edge and one set of the largest out-degree. Vertices are added and reported in input
+        // order before any edge; edges are reported grouped by source, in
+        // input order within a source.
+        template <typename TIterator>
+        size_t AddEdges(TIterator begin, TIterator end, bool addVertices)
+        {
+            std::vector<TEdge> input(begin, end);
+            FlatHashMap<TVertexDescriptor, size_t> slots;
+            std::vector<size_t> slotOf;
+            slotOf.reserve(input.size());
+            std::vector<size_t> starts(1, 0);
+            for (const auto& edge : input)
+            {
+                if (addVertices)
+                {
+                    AddVertex(edge.Source());
+                    AddVertex(edge.Target());
+                }
+                size_t slot = *slots.Insert(edge.Source(), starts.size() - 1).first;
+                if (slot + 1 == starts.size())
+                {
+                    starts.push_back(0);
+                }
+                ++starts[slot + 1];
+                slotOf.push_back(slot);
+            }
+            slots = FlatHashMap<TVertexDescriptor, size_t>();
+            for (size_t slot = 1; slot < starts.size(); ++slot)
+            {
+                starts[slot] += starts[slot - 1];
+            }
+            std::vector<size_t> order(input.size());
+            {
+                std::vector<size_t> positions(starts.begin(), starts.end() - 1);
+                for (size_t index = 0; index < input.size(); ++index)
+                {
+                    order[positions[slotOf[index]]++] = index;
+                }
+            }
+            slotOf = std::vector<size_t>();
+
+            HashSet<TVertexDescriptor> targets;
+            size_t count = 0;
+            for (size_t slot = 0; slot + 1 < starts.size(); ++slot)
+            {
+                // Nothing is inserted into the vertex table while the list
+                // is in use, so a flat table cannot move it
+                auto& edges = EdgesOf(input[order[starts[slot]]].Source());
+                bool scan = edges.size() + starts[slot + 1] - starts[slot] <=
+                    kDeduplicationScanLimit;
+                if (!allowParallelEdges_ && !scan)
+                {
+                    targets = HashSet<TVertexDescriptor>();
+                    targets.reserve(edges.size() + starts[slot + 1] - starts[slot]);
+                    for (const auto& existing : edges)
+                    {
+                        targets.insert(existing.Target());
+                    }
+                }
+                for (size_t position = starts[slot]; position < starts[slot + 1]; ++position)
+                {
+                    const TEdge& edge = input[order[position]];
+                    if (!allowParallelEdges_ && (scan ?
+                        std::any_of(edges.begin(), edges.end(), [&edge](const TEdge& existing)
+                        {
+                            return existing.Target() == edge.Target();
+                        }) :
+                        !targets.insert(edge.Target()).second))
+                    {
+                        continue;
+                    }
+                    AppendEdge(edges, edge);
+                    ++edgeCount_;
+                    edgeAddedAction_(edge);
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        // Lists share the allocator of the vertex table, so a pooled graph
+        // keeps all its nodes in one pool whatever scope is open now
+        TEdgeList& EdgesOf(const TVertexDescriptor& vertex)
+        {
+            return vertexEdges_.try_emplace(vertex, vertexEdges_.get_allocator()).first->second;
+        }
+
+        using EdgeListIterator = typename TEdgeList::iterator;
+
+        // First out-edge to a target in list order, and the number of
+        // parallel edges to it
+        struct MembershipEntry
+        {
+            EdgeListIterator first;
+            size_t count;
+        };
+
+        using MembershipIndex = FlatHashMap<TVertexDescriptor, MembershipEntry>;
+
+        void RebuildMembershipIndices()
+        {
+            membershipIndices_.clear();
+            if (!TContainerPolicy::kStableEdgeIterators)
+            {
+                return;
+            }
+            for (auto& vertexEdgesPair : vertexEdges_)
+            {
+                if (vertexEdgesPair.second.size() >= membershipIndexThreshold_)
+                {
+                    BuildMembershipIndex(vertexEdgesPair.first, vertexEdgesPair.second);
+                }
+            }
+        }
+
+        void BuildMembershipIndex(const TVertexDescriptor& source, TEdgeList& edges)
+        {
+            auto& index = membershipIndices_[source];
+            index.Reserve(edges.size());
+            for (auto iedge = edges.begin(); iedge != edges.end(); ++iedge)
+            {
+                ++index.Insert(iedge->Target(), MembershipEntry{ iedge, 0 }).first->count;
+            }
+        }
+
+        // Every edge insertion funnels through here to keep the index current
+        void AppendEdge(TEdgeList& edges, const TEdge& edge)
+        {
+            edges.push_back(edge);
+            auto iindex = membershipIndices_.find(edge.Source());
+            if (iindex != membershipIndices_.end())
+            {
+                auto last = std::prev(edges.end());
+                ++iindex->second.Insert(edge.Target(), MembershipEntry{ last, 0 }).first->count;
+            }
+            else if (TContainerPolicy::kStableEdgeIterators &&
+                edges.size() >= membershipIndexThreshold_)
+            {
+                BuildMembershipIndex(edge.Source(), edges);
+            }
+        }
+
+        // Called before iedge leaves edges. The index is dropped once the
+        // degree falls well below the threshold, so a vertex hovering around
+        // it does not rebuild over and over.
+        void UnindexEdge(TEdgeList& edges, EdgeListIterator iedge)
+        {
+            auto iindex = membershipIndices_.find(iedge->Source());
+            if (iindex == membershipIndices_.end())
+            {
+                return;
+            }
+            if (edges.size() - 1 < membershipIndexThreshold_ / 2)
+            {
+                membershipIndices_.erase(iindex);
+                return;
+            }
+            auto& index = iindex->second;
+            auto* entry = index.Find(iedge->Target());
+            if (--entry->count == 0)
+            {
+                index.Erase(iedge->Target());
+            }
+            else if (entry->first == iedge)
+            {
+                auto inext = std::next(iedge);
+                while (inext->Target() != iedge->Target())
+                {
+                    ++inext;
+                }
+                entry->first = inext;
+            }
+        }
+
+        // Vertices first, so every edge is reported between known vertices
+        void NotifyAdded()
+        {
+            if (vertexAddedAction_)
+            {
+                for (const auto& vertex : Vertices())
+                {
+                    vertexAddedAction_(vertex);
+                }
+            }
+            if (edgeAddedAction_)
+            {
+                for (const auto& vertexEdgesPair : vertexEdges_)
+                {
+                    for (const auto& edge : vertexEdgesPair.second)
+                    {
+                        edgeAddedAction_(edge);
+                    }
+                }
+            }
+        }
+
+        // Every edge removal funnels through here so observers see it
+        EdgeListIterator EraseEdge(TEdgeList& edges, EdgeListIterator iedge)
+        {
+            UnindexEdge(edges, iedge);
+            TEdge removed = *iedge;
+            auto inext = edges.erase(iedge);
+            --edgeCount_;
+            edgeRemovedAction_(removed);
+            return inext;
+        }
+
     private:
         bool allowParallelEdges_;
-        Dictionary<TVertexDescriptor, List<TEdge>> vertexEdges_;
+        TVertexTable vertexEdges_;
         size_t edgeCount_;
+        VertexAction<TVertexDescriptor> vertexAddedAction_;
+        EdgeAction<TVertexDescriptor, TEdge> edgeAddedAction_;
+        VertexAction<TVertexDescriptor> vertexRemovedAction_;
+        EdgeAction<TVertexDescriptor, TEdge> edgeRemovedAction_;
+        size_t membershipIndexThreshold_;
+        Dictionary<TVertexDescriptor, MembershipIndex> membershipIndices_;
+    };
+
+    template <typename VertexDescriptor, typename Edge, typename TContainerPolicy>
+    struct DefaultPropertyMapSelector<AdjacencyGraph<VertexDescriptor, Edge, TContainerPolicy>>
+    {
+        using type = BasicHashPropertyMapSelector<TContainerPolicy>;
+    };
+
+    template <typename VertexDescriptor, typename Edge, typename TContainerPolicy>
+    struct DefaultContainerPolicy<AdjacencyGraph<VertexDescriptor, Edge, TContainerPolicy>>
+    {
+        using type = TContainerPolicy;
     };
 }
 
-#endif
+#endif
\ No newline at end of file
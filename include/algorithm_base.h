@@ -1,14 +1,17 @@
 #ifndef STRONGLY_CONNECTED_COMPONENTS_ALGORITHM_BASE_H_
 #define STRONGLY_CONNECTED_COMPONENTS_ALGORITHM_BASE_H_
 
+#include "algorithm_statistics.h"
+
 namespace Graph
 {
-    template <typename TGraph>
+    template <typename TGraph, typename TStatistics = NoStatistics>
     class AlgorithmBase
     {
     protected:
         explicit AlgorithmBase(const TGraph& graph)
             : graph_(graph)
+            , statistics_()
         {}
 
     public:
@@ -17,11 +20,24 @@ namespace Graph
             return graph_;
         }
 
+        // Filled by Compute when TStatistics is CollectStatistics
+        const TStatistics& GetStatistics() const
+        {
+            return statistics_;
+        }
+
         void Compute()
         {
+            statistics_.Reset();
+            statistics_.StartPhase(INITIALIZE);
             Initialize();
+            statistics_.FinishPhase(INITIALIZE);
+            statistics_.StartPhase(COMPUTE);
             InternalCompute();
+            statistics_.FinishPhase(COMPUTE);
+            statistics_.StartPhase(CLEAR);
             Clear();
+            statistics_.FinishPhase(CLEAR);
         }
 
     protected:
@@ -33,8 +49,14 @@ namespace Graph
         virtual void Clear()
         {}
 
+        TStatistics& Statistics()
+        {
+            return statistics_;
+        }
+
     private:
         const TGraph& graph_;
+        TStatistics statistics_;
     };
 }
 
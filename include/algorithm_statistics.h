@@ -0,0 +1,210 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_ALGORITHM_STATISTICS_H_
+#define STRONGLY_CONNECTED_COMPONENTS_ALGORITHM_STATISTICS_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+#include "performance_counters.h"
+
+namespace Graph
+{
+    enum AlgorithmPhase
+    {
+        INITIALIZE, COMPUTE, CLEAR, PHASE_COUNT
+    };
+
+    struct AlgorithmStatistics
+    {
+        double phaseSeconds[PHASE_COUNT];
+        size_t discoveredVertices;
+        size_t examinedEdges;
+        size_t treeEdges;
+        size_t backEdges;
+        size_t forwardOrCrossEdges;
+        size_t maxStackDepth;
+        size_t peakResultBytes;
+    };
+
+    // Statistics policy of the algorithms. Every hook is an empty inline
+    // function, so an algorithm built with it compiles to the same code as
+    // one without statistics.
+    class NoStatistics
+    {
+    public:
+        static constexpr bool kEnabled = false;
+
+        void Reset()
+        {}
+
+        void StartPhase(AlgorithmPhase phase)
+        {}
+
+        void FinishPhase(AlgorithmPhase phase)
+        {}
+
+        void DiscoverVertex()
+        {}
+
+        void ExamineEdge()
+        {}
+
+        void TreeEdge()
+        {}
+
+        void BackEdge()
+        {}
+
+        void ForwardOrCrossEdge()
+        {}
+
+        void StackDepth(size_t depth)
+        {}
+
+        void ResultBytes(size_t bytes)
+        {}
+
+        void Merge(const NoStatistics& other)
+        {}
+    };
+
+    // Statistics policy that counts traversal events, tracks the deepest
+    // search stack and the largest result maps, and times the phases of
+    // AlgorithmBase::Compute.
+    class CollectStatistics
+    {
+    public:
+        static constexpr bool kEnabled = true;
+
+        CollectStatistics()
+            : statistics_()
+            , phaseStart_()
+        {}
+
+        const AlgorithmStatistics& Get() const
+        {
+            return statistics_;
+        }
+
+        void Reset()
+        {
+            statistics_ = AlgorithmStatistics();
+        }
+
+        void StartPhase(AlgorithmPhase phase)
+        {
+            phaseStart_ = std::chrono::steady_clock::now();
+        }
+
+        void FinishPhase(AlgorithmPhase phase)
+        {
+            statistics_.phaseSeconds[phase] += std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - phaseStart_).count();
+        }
+
+        void DiscoverVertex()
+        {
+            ++statistics_.discoveredVertices;
+        }
+
+        void ExamineEdge()
+        {
+            ++statistics_.examinedEdges;
+        }
+
+        void TreeEdge()
+        {
+            ++statistics_.treeEdges;
+        }
+
+        void BackEdge()
+        {
+            ++statistics_.backEdges;
+        }
+
+        void ForwardOrCrossEdge()
+        {
+            ++statistics_.forwardOrCrossEdges;
+        }
+
+        void StackDepth(size_t depth)
+        {
+            statistics_.maxStackDepth = std::max(statistics_.maxStackDepth, depth);
+        }
+
+        void ResultBytes(size_t bytes)
+        {
+            statistics_.peakResultBytes = std::max(statistics_.peakResultBytes, bytes);
+        }
+
+        // Folds in the events of a nested algorithm; phase times stay ours
+        void Merge(const CollectStatistics& other)
+        {
+            const auto& nested = other.statistics_;
+            statistics_.discoveredVertices += nested.discoveredVertices;
+            statistics_.examinedEdges += nested.examinedEdges;
+            statistics_.treeEdges += nested.treeEdges;
+            statistics_.backEdges += nested.backEdges;
+            statistics_.forwardOrCrossEdges += nested.forwardOrCrossEdges;
+            StackDepth(nested.maxStackDepth);
+            ResultBytes(nested.peakResultBytes);
+        }
+
+    private:
+        AlgorithmStatistics statistics_;
+        std::chrono::steady_clock::time_point phaseStart_;
+    };
+
+    // CollectStatistics that also reads the hardware counters around each
+    // phase of AlgorithmBase::Compute. Counters the system does not offer
+    // are reported unavailable; the rest of the statistics still work.
+    class CollectPerformanceStatistics : public CollectStatistics
+    {
+    public:
+        CollectPerformanceStatistics()
+            : CollectStatistics()
+            , counters_()
+            , phaseCounts_()
+        {
+            Reset();
+        }
+
+        const PerformanceCounts& GetPhaseCounts(AlgorithmPhase phase) const
+        {
+            return phaseCounts_[phase];
+        }
+
+        void Reset()
+        {
+            CollectStatistics::Reset();
+            for (auto& counts : phaseCounts_)
+            {
+                counts = counters_.Get();
+                std::fill(counts.values, counts.values + PERFORMANCE_EVENT_COUNT, 0);
+            }
+        }
+
+        void StartPhase(AlgorithmPhase phase)
+        {
+            counters_.Reset();
+            CollectStatistics::StartPhase(phase);
+            counters_.Start();
+        }
+
+        void FinishPhase(AlgorithmPhase phase)
+        {
+            counters_.Stop();
+            CollectStatistics::FinishPhase(phase);
+            for (int event = 0; event < PERFORMANCE_EVENT_COUNT; ++event)
+            {
+                phaseCounts_[phase].values[event] += counters_.Get().values[event];
+            }
+        }
+
+    private:
+        PerformanceCounters counters_;
+        PerformanceCounts phaseCounts_[PHASE_COUNT];
+    };
+}
+
+#endif
\ No newline at end of file
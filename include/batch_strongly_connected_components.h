@@ -0,0 +1,149 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_BATCH_STRONGLY_CONNECTED_COMPONENTS_H_
+#define STRONGLY_CONNECTED_COMPONENTS_BATCH_STRONGLY_CONNECTED_COMPONENTS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "iterator_tools.h"
+#include "work_stealing_thread_pool.h"
+#include "strongly_connected_component_algorithm.h"
+
+namespace Graph
+{
+    // Runs StronglyConnectedComponentAlgorithm over many independent graphs
+    // on a fixed pool. Every worker slot keeps its own workspace across
+    // graphs and batches, so small graphs cost no allocations once the
+    // workspaces have grown.
+    //
+    // Results of graph i occupy [GetOffsets()[i], GetOffsets()[i + 1]) of
+    // one contiguous buffer, one component id per vertex in the order
+    // graph.Vertices() enumerates them. Ids are those of the single-graph
+    // algorithm: dense and in reverse topological order.
+    template <typename TGraph, typename TPropertyMapSelector =
+        typename DefaultPropertyMapSelector<TGraph>::type, typename TContainerPolicy =
+            typename DefaultContainerPolicy<TGraph>::type>
+    class BatchStronglyConnectedComponents
+    {
+    public:
+        using TAlgorithm = StronglyConnectedComponentAlgorithm<TGraph,
+            TPropertyMapSelector, NoStatistics, TContainerPolicy>;
+        using TWorkspace = typename TAlgorithm::TWorkspace;
+        using ConstComponentIterator = std::vector<size_t>::const_iterator;
+
+        // threadCount == 0 uses every hardware thread
+        explicit BatchStronglyConnectedComponents(size_t threadCount = 0)
+            : pool_(threadCount)
+            , workspaces_()
+            , components_()
+            , offsets_(1, 0)
+            , componentsCounts_()
+        {
+            for (size_t slot = 0; slot < pool_.ThreadCount(); ++slot)
+            {
+                workspaces_.emplace_back(new TWorkspace());
+            }
+        }
+
+        size_t ThreadCount() const
+        {
+            return pool_.ThreadCount();
+        }
+
+        // Rethrows the first exception raised by any graph
+        void Compute(const TGraph* graphs, size_t graphCount)
+        {
+            offsets_.assign(graphCount + 1, 0);
+            for (size_t index = 0; index < graphCount; ++index)
+            {
+                offsets_[index + 1] = offsets_[index] + graphs[index].VertexCount();
+            }
+            components_.resize(offsets_.back());
+            componentsCounts_.assign(graphCount, 0);
+
+            std::atomic<size_t> nextGraph(0);
+            size_t slotCount = std::min(workspaces_.size(),
+                (graphCount + kBatchGrain - 1) / kBatchGrain);
+            TaskGroup group(pool_);
+            for (size_t slot = 0; slot < slotCount; ++slot)
+            {
+                group.Run([this, graphs, graphCount, slot, &nextGraph]()
+                {
+                    TWorkspace& workspace = *workspaces_[slot];
+                    size_t begin;
+                    while ((begin = nextGraph.fetch_add(kBatchGrain)) < graphCount)
+                    {
+                        size_t end = std::min(graphCount, begin + kBatchGrain);
+                        for (size_t index = begin; index < end; ++index)
+                        {
+                            ComputeOne(graphs[index], index, workspace);
+                        }
+                    }
+                });
+            }
+            group.Wait();
+        }
+
+        void Compute(const std::vector<TGraph>& graphs)
+        {
+            Compute(graphs.data(), graphs.size());
+        }
+
+        size_t GraphCount() const
+        {
+            return componentsCounts_.size();
+        }
+
+        const std::vector<size_t>& GetComponents() const
+        {
+            return components_;
+        }
+
+        IteratorRange<ConstComponentIterator> GetComponents(size_t graph) const
+        {
+            return IteratorRange<ConstComponentIterator>(
+                components_.begin() + offsets_[graph],
+                components_.begin() + offsets_[graph + 1]);
+        }
+
+        // GraphCount() + 1 entries
+        const std::vector<size_t>& GetOffsets() const
+        {
+            return offsets_;
+        }
+
+        size_t GetComponentsCount(size_t graph) const
+        {
+            return componentsCounts_[graph];
+        }
+
+    private:
+        // Graphs claimed per atomic increment; small graphs finish in well
+        // under a microsecond
+        static constexpr size_t kBatchGrain = 8;
+
+        void ComputeOne(const TGraph& graph, size_t index, TWorkspace& workspace)
+        {
+            TAlgorithm algo(graph, workspace);
+            algo.Compute();
+            const auto& components = algo.GetComponents();
+            size_t position = offsets_[index];
+            for (const auto& vertex : graph.Vertices())
+            {
+                components_[position++] = components[vertex];
+            }
+            componentsCounts_[index] = algo.GetComponentsCount();
+        }
+
+    private:
+        WorkStealingThreadPool pool_;
+        std::vector<std::unique_ptr<TWorkspace>> workspaces_;
+        std::vector<size_t> components_;
+        std::vector<size_t> offsets_;
+        std::vector<size_t> componentsCounts_;
+    };
+}
+
+#endif
\ No newline at end of file
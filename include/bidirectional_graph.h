@@ -0,0 +1,477 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_BIDIRECTIONAL_GRAPH_H_
+#define STRONGLY_CONNECTED_COMPONENTS_BIDIRECTIONAL_GRAPH_H_
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "iterator_tools.h"
+#include "graph_containers.h"
+#include "edge.h"
+
+namespace Graph
+{
+    // Directed graph that keeps the in-edges of every vertex next to its
+    // out-edges. Both copies of an edge know where the other one lives, so
+    // removing an edge is O(1) once it is found and removing a vertex only
+    // touches its incident edges.
+    template <typename VertexDescriptor, typename Edge>
+    class BidirectionalGraph
+    {
+        struct OutEntry;
+        using OutList = List<OutEntry>;
+        // Edge copy stored at the target, with the position of the original
+        using InEntry = std::pair<Edge, typename OutList::iterator>;
+        using InList = List<InEntry>;
+
+        // Edge stored at the source, with the position of its in-edge copy
+        struct OutEntry : std::pair<Edge, typename InList::iterator>
+        {
+            OutEntry(const Edge& edge)
+                : std::pair<Edge, typename InList::iterator>(edge, typename InList::iterator())
+            {}
+        };
+
+        struct VertexEdges
+        {
+            OutList outEdges;
+            InList inEdges;
+        };
+
+    public:
+        using TVertexDescriptor = VertexDescriptor;
+        using TEdge = Edge;
+
+        using ConstVertexIterator = KeyIterator<
+            typename Dictionary<TVertexDescriptor, VertexEdges>::const_iterator>;
+        using ConstEdgeIterator = KeyIterator<typename OutList::const_iterator>;
+        using ConstInEdgeIterator = KeyIterator<typename InList::const_iterator>;
+
+        BidirectionalGraph()
+            : BidirectionalGraph(false)
+        {}
+
+        explicit BidirectionalGraph(bool allowParallelEdges)
+            : allowParallelEdges_(allowParallelEdges)
+            , vertexEdges_()
+            , edgeCount_(0)
+        {}
+
+        // Copies are rebuilt edge by edge since the lists point at each other
+        BidirectionalGraph(const BidirectionalGraph& other)
+            : allowParallelEdges_(other.allowParallelEdges_)
+            , vertexEdges_()
+            , edgeCount_(0)
+        {
+            CopyFrom(other);
+        }
+
+        BidirectionalGraph(BidirectionalGraph&& other) = default;
+
+        BidirectionalGraph& operator=(const BidirectionalGraph& other)
+        {
+            if (this != &other)
+            {
+                vertexEdges_.clear();
+                edgeCount_ = 0;
+                allowParallelEdges_ = other.allowParallelEdges_;
+                CopyFrom(other);
+            }
+            return *this;
+        }
+
+        BidirectionalGraph& operator=(BidirectionalGraph&& other) = default;
+
+        bool IsDirected() const
+        {
+            return true;
+        }
+
+        bool AllowParallelEdges() const
+        {
+            return allowParallelEdges_;
+        }
+
+        size_t VertexCount() const
+        {
+            return vertexEdges_.size();
+        }
+
+        bool IsVerticesEmpty() const
+        {
+            return VertexCount() == 0;
+        }
+
+        IteratorRange<ConstVertexIterator> Vertices() const
+        {
+            return IteratorRange<ConstVertexIterator>(
+                ConstVertexIterator(vertexEdges_.begin()),
+                ConstVertexIterator(vertexEdges_.end()));
+        }
+
+        bool ContainsVertex(const TVertexDescriptor& vertex) const
+        {
+            return vertexEdges_.find(vertex) != vertexEdges_.end();
+        }
+
+        bool IsOutEdgesEmpty(const TVertexDescriptor& vertex) const
+        {
+            return vertexEdges_.find(vertex)->second.outEdges.empty();
+        }
+
+        size_t OutDegree(const TVertexDescriptor& vertex) const
+        {
+            return vertexEdges_.find(vertex)->second.outEdges.size();
+        }
+
+        IteratorRange<ConstEdgeIterator> OutEdges(const TVertexDescriptor& vertex) const
+        {
+            const auto& edges = vertexEdges_.find(vertex)->second.outEdges;
+            return IteratorRange<ConstEdgeIterator>(
+                ConstEdgeIterator(edges.begin()), ConstEdgeIterator(edges.end()));
+        }
+
+        bool TryGetEdges(const TVertexDescriptor& vertex,
+            IteratorRange<ConstEdgeIterator>& range) const
+        {
+            if (ContainsVertex(vertex))
+            {
+                range = OutEdges(vertex);
+                return true;
+            }
+            return false;
+        }
+
+        bool IsInEdgesEmpty(const TVertexDescriptor& vertex) const
+        {
+            return vertexEdges_.find(vertex)->second.inEdges.empty();
+        }
+
+        size_t InDegree(const TVertexDescriptor& vertex) const
+        {
+            return vertexEdges_.find(vertex)->second.inEdges.size();
+        }
+
+        // Edges ending at vertex, with their original direction
+        IteratorRange<ConstInEdgeIterator> InEdges(const TVertexDescriptor& vertex) const
+        {
+            const auto& edges = vertexEdges_.find(vertex)->second.inEdges;
+            return IteratorRange<ConstInEdgeIterator>(
+                ConstInEdgeIterator(edges.begin()), ConstInEdgeIterator(edges.end()));
+        }
+
+        bool TryGetInEdges(const TVertexDescriptor& vertex,
+            IteratorRange<ConstInEdgeIterator>& range) const
+        {
+            if (ContainsVertex(vertex))
+            {
+                range = InEdges(vertex);
+                return true;
+            }
+            return false;
+        }
+
+        size_t Degree(const TVertexDescriptor& vertex) const
+        {
+            return OutDegree(vertex) + InDegree(vertex);
+        }
+
+        size_t EdgeCount() const
+        {
+            return edgeCount_;
+        }
+
+        List<TEdge> GetEdges() const
+        {
+            List<TEdge> edges;
+            for (const auto& vertexEdgesPair : vertexEdges_)
+            {
+                for (const auto& entry : vertexEdgesPair.second.outEdges)
+                {
+                    edges.push_back(entry.first);
+                }
+            }
+            return edges;
+        }
+
+        // Walks the shorter of the source's out-list and the target's in-list
+        bool ContainsEdge(const TVertexDescriptor& source,
+            const TVertexDescriptor& target) const
+        {
+            auto isource = vertexEdges_.find(source);
+            auto itarget = vertexEdges_.find(target);
+            if (isource == vertexEdges_.end() || itarget == vertexEdges_.end())
+            {
+                return false;
+            }
+            const auto& outEdges = isource->second.outEdges;
+            const auto& inEdges = itarget->second.inEdges;
+            if (outEdges.size() <= inEdges.size())
+            {
+                for (const auto& entry : outEdges)
+                {
+                    if (entry.first.Target() == target)
+                    {
+                        return true;
+                    }
+                }
+            }
+            else
+            {
+                for (const auto& entry : inEdges)
+                {
+                    if (entry.first.Source() == source)
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        bool ContainsEdge(const TEdge& edge) const
+        {
+            return ContainsEdge(edge.Source(), edge.Target());
+        }
+
+        bool AddVertex(const TVertexDescriptor& vertex)
+        {
+            return vertexEdges_.emplace(vertex, VertexEdges()).second;
+        }
+
+        template <typename TIterator>
+        size_t AddVertexRange(TIterator begin, TIterator end)
+        {
+            size_t count = 0;
+            for (auto ivertex = begin; ivertex != end; ++ivertex)
+            {
+                if (AddVertex(*ivertex))
+                {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        // O(degree of vertex)
+        bool RemoveVertex(const TVertexDescriptor& vertex)
+        {
+            auto ivertex = vertexEdges_.find(vertex);
+            if (ivertex == vertexEdges_.end())
+            {
+                return false;
+            }
+            auto& edges = ivertex->second;
+            while (!edges.outEdges.empty())
+            {
+                EraseEdge(edges.outEdges.begin());
+            }
+            while (!edges.inEdges.empty())
+            {
+                EraseEdge(edges.inEdges.begin()->second);
+            }
+            vertexEdges_.erase(ivertex);
+            return true;
+        }
+
+        template <typename Predicate>
+        size_t RemoveVertexIf(Predicate pred)
+        {
+            List<TVertexDescriptor> toRemove;
+            for (const auto& vertex : Vertices())
+            {
+                if (pred(vertex))
+                {
+                    toRemove.push_back(vertex);
+                }
+            }
+            for (const auto& vertex : toRemove)
+            {
+                RemoveVertex(vertex);
+            }
+            return toRemove.size();
+        }
+
+        bool AddVerticesAndEdge(const TEdge& edge)
+        {
+            AddVertex(edge.Source());
+            AddVertex(edge.Target());
+            return AddEdge(edge);
+        }
+
+        template <typename TIterator>
+        size_t AddVerticesAndEdgeRange(TIterator begin, TIterator end)
+        {
+            size_t count = 0;
+            for (auto iedge = begin; iedge != end; ++iedge)
+            {
+                if (AddVerticesAndEdge(*iedge))
+                {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        // Missing endpoints are added silently
+        bool AddEdge(const TEdge& edge)
+        {
+            if (!allowParallelEdges_ && ContainsEdge(edge))
+            {
+                return false;
+            }
+            auto& outEdges = vertexEdges_[edge.Source()].outEdges;
+            auto& inEdges = vertexEdges_[edge.Target()].inEdges;
+            auto iout = outEdges.emplace(outEdges.end(), edge);
+            iout->second = inEdges.emplace(inEdges.end(), edge, iout);
+            ++edgeCount_;
+            return true;
+        }
+
+        template <typename TIterator>
+        size_t AddEdgeRange(TIterator begin, TIterator end)
+        {
+            size_t count = 0;
+            for (auto iedge = begin; iedge != end; ++iedge)
+            {
+                if (AddEdge(*iedge))
+                {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        bool RemoveEdge(const TEdge& edge)
+        {
+            auto isource = vertexEdges_.find(edge.Source());
+            if (isource == vertexEdges_.end())
+            {
+                return false;
+            }
+            auto& outEdges = isource->second.outEdges;
+            for (auto iedge = outEdges.begin(); iedge != outEdges.end(); ++iedge)
+            {
+                if (iedge->first.Target() == edge.Target())
+                {
+                    EraseEdge(iedge);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <typename Predicate>
+        size_t RemoveEdgeIf(Predicate pred)
+        {
+            size_t count = 0;
+            for (auto& vertexEdgesPair : vertexEdges_)
+            {
+                count += RemoveOutEdgesIf(vertexEdgesPair.first, pred);
+            }
+            return count;
+        }
+
+        void ClearOutEdges(const TVertexDescriptor& vertex)
+        {
+            auto& outEdges = vertexEdges_.find(vertex)->second.outEdges;
+            while (!outEdges.empty())
+            {
+                EraseEdge(outEdges.begin());
+            }
+        }
+
+        template <typename Predicate>
+        size_t RemoveOutEdgesIf(const TVertexDescriptor& vertex, Predicate pred)
+        {
+            size_t count = 0;
+            auto& outEdges = vertexEdges_.find(vertex)->second.outEdges;
+            for (auto iedge = outEdges.begin(); iedge != outEdges.end();)
+            {
+                auto inext = std::next(iedge);
+                if (pred(iedge->first))
+                {
+                    EraseEdge(iedge);
+                    ++count;
+                }
+                iedge = inext;
+            }
+            return count;
+        }
+
+        void ClearInEdges(const TVertexDescriptor& vertex)
+        {
+            auto& inEdges = vertexEdges_.find(vertex)->second.inEdges;
+            while (!inEdges.empty())
+            {
+                EraseEdge(inEdges.begin()->second);
+            }
+        }
+
+        template <typename Predicate>
+        size_t RemoveInEdgesIf(const TVertexDescriptor& vertex, Predicate pred)
+        {
+            size_t count = 0;
+            auto& inEdges = vertexEdges_.find(vertex)->second.inEdges;
+            for (auto iedge = inEdges.begin(); iedge != inEdges.end();)
+            {
+                auto inext = std::next(iedge);
+                if (pred(iedge->first))
+                {
+                    EraseEdge(iedge->second);
+                    ++count;
+                }
+                iedge = inext;
+            }
+            return count;
+        }
+
+        void ClearEdges(const TVertexDescriptor& vertex)
+        {
+            ClearOutEdges(vertex);
+            ClearInEdges(vertex);
+        }
+
+        void Clear()
+        {
+            vertexEdges_.clear();
+            edgeCount_ = 0;
+        }
+
+    private:
+        // Unlinks both copies of the edge stored at iedge
+        void EraseEdge(typename OutList::iterator iedge)
+        {
+            const TEdge& edge = iedge->first;
+            vertexEdges_.find(edge.Target())->second.inEdges.erase(iedge->second);
+            vertexEdges_.find(edge.Source())->second.outEdges.erase(iedge);
+            --edgeCount_;
+        }
+
+        void CopyFrom(const BidirectionalGraph& other)
+        {
+            for (const auto& vertex : other.Vertices())
+            {
+                AddVertex(vertex);
+            }
+            for (const auto& vertexEdgesPair : other.vertexEdges_)
+            {
+                auto& outEdges = vertexEdges_.find(vertexEdgesPair.first)->second.outEdges;
+                for (const auto& entry : vertexEdgesPair.second.outEdges)
+                {
+                    auto& inEdges = vertexEdges_.find(entry.first.Target())->second.inEdges;
+                    auto iout = outEdges.emplace(outEdges.end(), entry.first);
+                    iout->second = inEdges.emplace(inEdges.end(), entry.first, iout);
+                    ++edgeCount_;
+                }
+            }
+        }
+
+    private:
+        bool allowParallelEdges_;
+        Dictionary<TVertexDescriptor, VertexEdges> vertexEdges_;
+        size_t edgeCount_;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,168 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_BINARY_GRAPH_FORMAT_H_
+#define STRONGLY_CONNECTED_COMPONENTS_BINARY_GRAPH_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "property_map.h"
+
+namespace Graph
+{
+    // On-disk compressed sparse row layout, in native byte order:
+    //   BinaryGraphHeader
+    //   uint64_t offsets[vertexCount + 1]
+    //   TVertexDescriptor targets[edgeCount]
+    // Every section starts 8-byte aligned, so a mapped file can be used in
+    // place.
+    struct BinaryGraphHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t targetSize;
+        uint64_t vertexCount;
+        uint64_t edgeCount;
+    };
+
+    static_assert(sizeof(BinaryGraphHeader) == 32, "unexpected BinaryGraphHeader padding");
+
+    constexpr char kBinaryGraphMagic[8] = { 'S', 'C', 'C', 'G', 'R', 'A', 'P', 'H' };
+    constexpr uint32_t kBinaryGraphVersion = 1;
+
+    // Throws when a crafted header describes sections too large to address,
+    // instead of letting the size wrap around to something plausible
+    inline size_t BinaryGraphFileSize(const BinaryGraphHeader& header)
+    {
+        const size_t kMaxSize = std::numeric_limits<size_t>::max();
+        size_t size = sizeof(BinaryGraphHeader);
+        if (header.vertexCount >= (kMaxSize - size) / sizeof(uint64_t))
+        {
+            throw std::runtime_error("binary graph vertex count is out of range");
+        }
+        size += static_cast<size_t>(header.vertexCount + 1) * sizeof(uint64_t);
+        if (header.targetSize != 0 && header.edgeCount > (kMaxSize - size) / header.targetSize)
+        {
+            throw std::runtime_error("binary graph edge count is out of range");
+        }
+        return size + static_cast<size_t>(header.edgeCount) * header.targetSize;
+    }
+
+    // Checks everything that can be checked without reading the arrays
+    inline void ValidateBinaryGraphHeader(const BinaryGraphHeader& header,
+        size_t fileSize, size_t targetSize)
+    {
+        if (std::memcmp(header.magic, kBinaryGraphMagic, sizeof(kBinaryGraphMagic)) != 0)
+        {
+            throw std::runtime_error("not a binary graph file");
+        }
+        if (header.version != kBinaryGraphVersion)
+        {
+            throw std::runtime_error("unsupported binary graph version");
+        }
+        if (header.targetSize != targetSize)
+        {
+            throw std::runtime_error("binary graph vertex size mismatch");
+        }
+        if (BinaryGraphFileSize(header) != fileSize)
+        {
+            throw std::runtime_error("binary graph file is truncated or corrupt");
+        }
+    }
+
+    // Checks the arrays in one pass: offsets start at 0, never decrease and
+    // end at edgeCount, and every target is a vertex. O(V + E).
+    template <typename TVertexDescriptor>
+    void ValidateBinaryGraphArrays(const uint64_t* offsets, const TVertexDescriptor* targets,
+        uint64_t vertexCount, uint64_t edgeCount)
+    {
+        if (offsets[0] != 0 || offsets[vertexCount] != edgeCount)
+        {
+            throw std::runtime_error("binary graph offsets do not span the targets");
+        }
+        for (uint64_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            if (offsets[vertex + 1] < offsets[vertex])
+            {
+                throw std::runtime_error("binary graph offsets decrease at vertex " +
+                    std::to_string(vertex));
+            }
+        }
+        for (uint64_t edge = 0; edge < edgeCount; ++edge)
+        {
+            if (targets[edge] < TVertexDescriptor(0) ||
+                static_cast<uint64_t>(targets[edge]) >= vertexCount)
+            {
+                throw std::runtime_error("binary graph target " + std::to_string(edge) +
+                    " is not a vertex");
+            }
+        }
+    }
+
+    // Writes any graph with non-negative integral vertex descriptors.
+    // Descriptors missing from the graph but below its largest one become
+    // isolated vertices, as in MakeCompressedSparseRowGraph.
+    template <typename TGraph>
+    void WriteBinaryGraph(const TGraph& graph, const std::string& path)
+    {
+        using TVertexDescriptor = typename TGraph::TVertexDescriptor;
+        static_assert(std::is_integral<TVertexDescriptor>::value,
+            "WriteBinaryGraph requires integral vertex descriptors");
+
+        size_t vertexCount = VertexIndexBound(graph);
+        std::vector<uint64_t> offsets(vertexCount + 1, 0);
+        for (const auto& vertex : graph.Vertices())
+        {
+            offsets[static_cast<size_t>(vertex) + 1] = graph.OutDegree(vertex);
+        }
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            offsets[vertex + 1] += offsets[vertex];
+        }
+
+        BinaryGraphHeader header;
+        std::memcpy(header.magic, kBinaryGraphMagic, sizeof(kBinaryGraphMagic));
+        header.version = kBinaryGraphVersion;
+        header.targetSize = sizeof(TVertexDescriptor);
+        header.vertexCount = vertexCount;
+        header.edgeCount = offsets[vertexCount];
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            throw std::runtime_error("cannot create '" + path + "'");
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(offsets.data()),
+            offsets.size() * sizeof(uint64_t));
+
+        std::vector<TVertexDescriptor> targets;
+        for (size_t index = 0; index < vertexCount; ++index)
+        {
+            auto vertex = static_cast<TVertexDescriptor>(index);
+            if (!graph.ContainsVertex(vertex))
+            {
+                continue;
+            }
+            targets.clear();
+            for (const auto& edge : graph.OutEdges(vertex))
+            {
+                targets.push_back(edge.Target());
+            }
+            out.write(reinterpret_cast<const char*>(targets.data()),
+                targets.size() * sizeof(TVertexDescriptor));
+        }
+        out.flush();
+        if (!out)
+        {
+            throw std::runtime_error("cannot write '" + path + "'");
+        }
+    }
+}
+
+#endif
\ No newline at end of file
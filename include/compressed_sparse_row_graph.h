@@ -0,0 +1,291 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_COMPRESSED_SPARSE_ROW_GRAPH_H_
+#define STRONGLY_CONNECTED_COMPONENTS_COMPRESSED_SPARSE_ROW_GRAPH_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "iterator_tools.h"
+#include "graph_containers.h"
+#include "out_edge_iterator.h"
+#include "property_map.h"
+#include "edge.h"
+
+namespace Graph
+{
+    // Immutable directed graph in compressed sparse row layout. Vertices are
+    // the integers [0, VertexCount()); the out-edges of vertex v are the
+    // targets stored in [offsets[v], offsets[v + 1]).
+    template <typename VertexDescriptor, typename Edge>
+    class CompressedSparseRowGraph
+    {
+        static_assert(std::is_integral<VertexDescriptor>::value,
+            "CompressedSparseRowGraph requires integral vertex descriptors");
+
+    public:
+        using TVertexDescriptor = VertexDescriptor;
+        using TEdge = Edge;
+
+        using ConstVertexIterator = CountingIterator<TVertexDescriptor>;
+        using ConstEdgeIterator = OutEdgeIterator<TEdge,
+            typename std::vector<TVertexDescriptor>::const_iterator>;
+
+        CompressedSparseRowGraph()
+            : offsets_(1, 0)
+            , targets_()
+        {}
+
+        // Takes over prepared arrays: offsets must hold vertexCount + 1
+        // non-decreasing entries starting at 0 and ending at targets.size().
+        CompressedSparseRowGraph(std::vector<size_t> offsets,
+            std::vector<TVertexDescriptor> targets)
+            : offsets_(std::move(offsets))
+            , targets_(std::move(targets))
+        {}
+
+        // Builds the graph from a forward range of edges with endpoints in
+        // [0, vertexCount). Out-edges of each vertex keep their input order.
+        template <typename TIterator>
+        CompressedSparseRowGraph(size_t vertexCount, TIterator begin, TIterator end)
+            : offsets_(vertexCount + 1, 0)
+            , targets_()
+        {
+            for (auto iedge = begin; iedge != end; ++iedge)
+            {
+                ++offsets_[static_cast<size_t>(iedge->Source()) + 1];
+            }
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                offsets_[vertex + 1] += offsets_[vertex];
+            }
+            targets_.resize(offsets_[vertexCount]);
+            std::vector<size_t> positions(offsets_.begin(), offsets_.end() - 1);
+            for (auto iedge = begin; iedge != end; ++iedge)
+            {
+                targets_[positions[static_cast<size_t>(iedge->Source())]++] =
+                    iedge->Target();
+            }
+        }
+
+        bool IsDirected() const
+        {
+            return true;
+        }
+
+        bool AllowParallelEdges() const
+        {
+            return true;
+        }
+
+        size_t VertexCount() const
+        {
+            return offsets_.size() - 1;
+        }
+
+        bool IsVerticesEmpty() const
+        {
+            return VertexCount() == 0;
+        }
+
+        IteratorRange<ConstVertexIterator> Vertices() const
+        {
+            return IteratorRange<ConstVertexIterator>(
+                ConstVertexIterator(0), ConstVertexIterator(VertexCount()));
+        }
+
+        bool ContainsVertex(const TVertexDescriptor& vertex) const
+        {
+            return !(vertex < TVertexDescriptor(0)) &&
+                static_cast<size_t>(vertex) < VertexCount();
+        }
+
+        bool IsOutEdgesEmpty(const TVertexDescriptor& vertex) const
+        {
+            return OutDegree(vertex) == 0;
+        }
+
+        size_t OutDegree(const TVertexDescriptor& vertex) const
+        {
+            auto index = static_cast<size_t>(vertex);
+            return offsets_[index + 1] - offsets_[index];
+        }
+
+        IteratorRange<ConstEdgeIterator> OutEdges(const TVertexDescriptor& vertex) const
+        {
+            auto index = static_cast<size_t>(vertex);
+            return IteratorRange<ConstEdgeIterator>(
+                ConstEdgeIterator(vertex, targets_.begin() + offsets_[index]),
+                ConstEdgeIterator(vertex, targets_.begin() + offsets_[index + 1]));
+        }
+
+        bool TryGetEdges(const TVertexDescriptor& vertex,
+            IteratorRange<ConstEdgeIterator>& range) const
+        {
+            if (ContainsVertex(vertex))
+            {
+                range = OutEdges(vertex);
+                return true;
+            }
+            return false;
+        }
+
+        size_t EdgeCount() const
+        {
+            return targets_.size();
+        }
+
+        List<TEdge> GetEdges() const
+        {
+            List<TEdge> edges;
+            for (const auto& vertex : Vertices())
+            {
+                for (const auto& edge : OutEdges(vertex))
+                {
+                    edges.push_back(edge);
+                }
+            }
+            return edges;
+        }
+
+        bool ContainsEdge(const TVertexDescriptor& source,
+            const TVertexDescriptor& target) const
+        {
+            if (!ContainsVertex(source))
+            {
+                return false;
+            }
+            auto index = static_cast<size_t>(source);
+            auto first = targets_.begin() + offsets_[index];
+            auto last = targets_.begin() + offsets_[index + 1];
+            return std::find(first, last, target) != last;
+        }
+
+        bool ContainsEdge(const TEdge& edge) const
+        {
+            return ContainsEdge(edge.Source(), edge.Target());
+        }
+
+        const std::vector<size_t>& Offsets() const
+        {
+            return offsets_;
+        }
+
+        const std::vector<TVertexDescriptor>& Targets() const
+        {
+            return targets_;
+        }
+
+    private:
+        std::vector<size_t> offsets_;
+        std::vector<TVertexDescriptor> targets_;
+    };
+
+    template <typename VertexDescriptor, typename Edge>
+    struct DefaultPropertyMapSelector<CompressedSparseRowGraph<VertexDescriptor, Edge>>
+    {
+        using type = VectorPropertyMapSelector;
+    };
+
+    // Static graphs are traversal-only, so searches use vector stacks
+    template <typename VertexDescriptor, typename Edge>
+    struct DefaultContainerPolicy<CompressedSparseRowGraph<VertexDescriptor, Edge>>
+    {
+        using type = FlatContainerPolicy;
+    };
+
+    // Freezes any graph with non-negative integral vertex descriptors (such
+    // as AdjacencyGraph<int, Edge<int>>). Descriptors missing from the source
+    // graph but below its largest one become isolated vertices.
+    template <typename TGraph>
+    CompressedSparseRowGraph<typename TGraph::TVertexDescriptor, typename TGraph::TEdge>
+        MakeCompressedSparseRowGraph(const TGraph& graph)
+    {
+        using TVertexDescriptor = typename TGraph::TVertexDescriptor;
+
+        size_t vertexCount = VertexIndexBound(graph);
+        std::vector<size_t> offsets(vertexCount + 1, 0);
+        for (const auto& vertex : graph.Vertices())
+        {
+            offsets[static_cast<size_t>(vertex) + 1] = graph.OutDegree(vertex);
+        }
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            offsets[vertex + 1] += offsets[vertex];
+        }
+        std::vector<TVertexDescriptor> targets(offsets[vertexCount]);
+        for (const auto& vertex : graph.Vertices())
+        {
+            auto position = offsets[static_cast<size_t>(vertex)];
+            for (const auto& edge : graph.OutEdges(vertex))
+            {
+                targets[position++] = edge.Target();
+            }
+        }
+        return CompressedSparseRowGraph<TVertexDescriptor, typename TGraph::TEdge>(
+            std::move(offsets), std::move(targets));
+    }
+
+    // Freezes any graph under a dense numbering of its vertices (see
+    // VertexIndexMap). The result is indexed by position, not by descriptor.
+    template <typename TGraph, typename TIndexMap>
+    CompressedSparseRowGraph<size_t, Edge<size_t>>
+        MakeCompressedSparseRowGraph(const TGraph& graph, const TIndexMap& indices)
+    {
+        size_t vertexCount = indices.VertexCount();
+        std::vector<size_t> offsets(vertexCount + 1, 0);
+        for (const auto& vertex : graph.Vertices())
+        {
+            offsets[indices.IndexOf(vertex) + 1] = graph.OutDegree(vertex);
+        }
+        for (size_t index = 0; index < vertexCount; ++index)
+        {
+            offsets[index + 1] += offsets[index];
+        }
+        std::vector<size_t> targets(offsets[vertexCount]);
+        for (const auto& vertex : graph.Vertices())
+        {
+            auto position = offsets[indices.IndexOf(vertex)];
+            for (const auto& edge : graph.OutEdges(vertex))
+            {
+                targets[position++] = indices.IndexOf(edge.Target());
+            }
+        }
+        return CompressedSparseRowGraph<size_t, Edge<size_t>>(
+            std::move(offsets), std::move(targets));
+    }
+
+    // Same vertices with every edge reversed
+    template <typename VertexDescriptor, typename Edge>
+    CompressedSparseRowGraph<VertexDescriptor, Edge> MakeTransposedGraph(
+        const CompressedSparseRowGraph<VertexDescriptor, Edge>& graph)
+    {
+        const auto& sourceOffsets = graph.Offsets();
+        const auto& sourceTargets = graph.Targets();
+        size_t vertexCount = graph.VertexCount();
+        std::vector<size_t> offsets(vertexCount + 1, 0);
+        for (const auto& target : sourceTargets)
+        {
+            ++offsets[static_cast<size_t>(target) + 1];
+        }
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            offsets[vertex + 1] += offsets[vertex];
+        }
+        std::vector<VertexDescriptor> targets(sourceTargets.size());
+        std::vector<size_t> positions(offsets.begin(), offsets.end() - 1);
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            for (size_t edge = sourceOffsets[vertex]; edge < sourceOffsets[vertex + 1]; ++edge)
+            {
+                targets[positions[static_cast<size_t>(sourceTargets[edge])]++] =
+                    VertexDescriptor(vertex);
+            }
+        }
+        return CompressedSparseRowGraph<VertexDescriptor, Edge>(
+            std::move(offsets), std::move(targets));
+    }
+}
+
+#endif
\ No newline at end of file
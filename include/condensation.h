@@ -0,0 +1,184 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_CONDENSATION_H_
+#define STRONGLY_CONNECTED_COMPONENTS_CONDENSATION_H_
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "iterator_tools.h"
+#include "compressed_sparse_row_graph.h"
+#include "edge.h"
+
+namespace Graph
+{
+    // Component DAG of a graph given a dense component numbering: one vertex
+    // per component, one edge per connected pair of distinct components, and
+    // the members of every component in one contiguous array.
+    //
+    // Tarjan and Pearce number components in reverse topological order; that
+    // is detected while the edges are laid out and the order then costs
+    // nothing. Any other numbering (e.g. Forward-Backward) gets a Kahn pass.
+    template <typename VertexDescriptor>
+    class Condensation
+    {
+    public:
+        using TVertexDescriptor = VertexDescriptor;
+        using TComponentGraph = CompressedSparseRowGraph<size_t, Edge<size_t>>;
+        using ConstMemberIterator = typename std::vector<TVertexDescriptor>::const_iterator;
+
+        template <typename TGraph, typename TComponentMap>
+        Condensation(const TGraph& graph, const TComponentMap& components,
+            size_t componentsCount)
+            : componentGraph_()
+            , memberOffsets_(componentsCount + 1, 0)
+            , members_()
+            , topologicalOrder_()
+        {
+            // Counting sort of the vertices by component
+            for (const auto& vertex : graph.Vertices())
+            {
+                ++memberOffsets_[components[vertex] + 1];
+            }
+            for (size_t component = 0; component < componentsCount; ++component)
+            {
+                memberOffsets_[component + 1] += memberOffsets_[component];
+            }
+            members_.resize(memberOffsets_[componentsCount]);
+            std::vector<size_t> positions(memberOffsets_.begin(), memberOffsets_.end() - 1);
+            for (const auto& vertex : graph.Vertices())
+            {
+                members_[positions[components[vertex]]++] = vertex;
+            }
+
+            // Component by component, so one stamp per target component is
+            // enough to drop duplicate edges
+            std::vector<size_t> offsets(componentsCount + 1, 0);
+            std::vector<size_t> targets;
+            std::vector<size_t> lastSource(componentsCount, kNoComponent);
+            bool reverseTopological = true;
+            for (size_t component = 0; component < componentsCount; ++component)
+            {
+                for (const auto& member : GetMembers(component))
+                {
+                    for (const auto& edge : graph.OutEdges(member))
+                    {
+                        size_t target = components[edge.Target()];
+                        if (target != component && lastSource[target] != component)
+                        {
+                            lastSource[target] = component;
+                            targets.push_back(target);
+                            reverseTopological = reverseTopological && target < component;
+                        }
+                    }
+                }
+                offsets[component + 1] = targets.size();
+            }
+            componentGraph_ = TComponentGraph(std::move(offsets), std::move(targets));
+
+            if (reverseTopological)
+            {
+                topologicalOrder_.reserve(componentsCount);
+                for (size_t component = componentsCount; component > 0; --component)
+                {
+                    topologicalOrder_.push_back(component - 1);
+                }
+            }
+            else
+            {
+                SortTopologically();
+            }
+        }
+
+        size_t GetComponentsCount() const
+        {
+            return componentGraph_.VertexCount();
+        }
+
+        // Vertices are component ids; edges are de-duplicated
+        const TComponentGraph& GetComponentGraph() const
+        {
+            return componentGraph_;
+        }
+
+        size_t GetComponentSize(size_t component) const
+        {
+            return memberOffsets_[component + 1] - memberOffsets_[component];
+        }
+
+        IteratorRange<ConstMemberIterator> GetMembers(size_t component) const
+        {
+            return IteratorRange<ConstMemberIterator>(
+                members_.begin() + memberOffsets_[component],
+                members_.begin() + memberOffsets_[component + 1]);
+        }
+
+        // componentsCount + 1 entries; members of c are
+        // GetMemberArray()[GetMemberOffsets()[c] .. GetMemberOffsets()[c + 1])
+        const std::vector<size_t>& GetMemberOffsets() const
+        {
+            return memberOffsets_;
+        }
+
+        const std::vector<TVertexDescriptor>& GetMemberArray() const
+        {
+            return members_;
+        }
+
+        // Every component edge points from an earlier to a later entry
+        const std::vector<size_t>& GetTopologicalOrder() const
+        {
+            return topologicalOrder_;
+        }
+
+    private:
+        static constexpr size_t kNoComponent = std::numeric_limits<size_t>::max();
+
+        void SortTopologically()
+        {
+            size_t componentsCount = componentGraph_.VertexCount();
+            const auto& targets = componentGraph_.Targets();
+            std::vector<size_t> inDegrees(componentsCount, 0);
+            for (auto target : targets)
+            {
+                ++inDegrees[target];
+            }
+            topologicalOrder_.reserve(componentsCount);
+            for (size_t component = 0; component < componentsCount; ++component)
+            {
+                if (inDegrees[component] == 0)
+                {
+                    topologicalOrder_.push_back(component);
+                }
+            }
+            const auto& offsets = componentGraph_.Offsets();
+            for (size_t position = 0; position < topologicalOrder_.size(); ++position)
+            {
+                size_t component = topologicalOrder_[position];
+                for (size_t edge = offsets[component]; edge < offsets[component + 1]; ++edge)
+                {
+                    if (--inDegrees[targets[edge]] == 0)
+                    {
+                        topologicalOrder_.push_back(targets[edge]);
+                    }
+                }
+            }
+        }
+
+    private:
+        TComponentGraph componentGraph_;
+        std::vector<size_t> memberOffsets_;
+        std::vector<TVertexDescriptor> members_;
+        std::vector<size_t> topologicalOrder_;
+    };
+
+    template <typename TGraph, typename TComponentMap>
+    Condensation<typename TGraph::TVertexDescriptor> MakeCondensation(
+        const TGraph& graph, const TComponentMap& components, size_t componentsCount)
+    {
+        return Condensation<typename TGraph::TVertexDescriptor>(
+            graph, components, componentsCount);
+    }
+}
+
+#endif
\ No newline at end of file
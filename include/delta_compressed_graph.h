@@ -0,0 +1,363 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_DELTA_COMPRESSED_GRAPH_H_
+#define STRONGLY_CONNECTED_COMPONENTS_DELTA_COMPRESSED_GRAPH_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "iterator_tools.h"
+#include "graph_containers.h"
+#include "property_map.h"
+#include "compressed_sparse_row_graph.h"
+#include "edge.h"
+
+namespace Graph
+{
+    // LEB128: seven bits per byte, low groups first, high bit set on every
+    // byte but the last
+    inline void AppendVarint(std::vector<uint8_t>& bytes, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            bytes.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<uint8_t>(value));
+    }
+
+    inline uint64_t ReadVarint(const uint8_t*& position)
+    {
+        uint64_t value = *position++;
+        if (value < 0x80)
+        {
+            return value;
+        }
+        value &= 0x7F;
+        for (int shift = 7; ; shift += 7)
+        {
+            uint64_t byte = *position++;
+            value |= (byte & 0x7F) << shift;
+            if (byte < 0x80)
+            {
+                return value;
+            }
+        }
+    }
+
+    // Decodes the targets of one vertex on the fly. The first target is
+    // stored as a zigzag gap from the source, the rest as gaps from their
+    // predecessor. Edges are returned by value.
+    template <typename Edge>
+    class DeltaEdgeIterator
+    {
+    public:
+        using TEdge = Edge;
+        using TVertexDescriptor = typename TEdge::TVertexDescriptor;
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TEdge;
+        using reference = TEdge;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ArrowProxy<TEdge>;
+
+        DeltaEdgeIterator()
+            : source_()
+            , target_(0)
+            , current_(nullptr)
+            , next_(nullptr)
+            , end_(nullptr)
+        {}
+
+        DeltaEdgeIterator(const TVertexDescriptor& source, const uint8_t* current,
+            const uint8_t* end)
+            : source_(source)
+            , target_(0)
+            , current_(current)
+            , next_(current)
+            , end_(end)
+        {
+            if (current_ != end_)
+            {
+                uint64_t gap = ReadVarint(next_);
+                int64_t delta = static_cast<int64_t>(gap >> 1) ^ -static_cast<int64_t>(gap & 1);
+                target_ = static_cast<uint64_t>(static_cast<int64_t>(source) + delta);
+            }
+        }
+
+        reference operator * () const
+        {
+            return TEdge(source_, TVertexDescriptor(target_));
+        }
+
+        pointer operator -> () const
+        {
+            return pointer(**this);
+        }
+
+        DeltaEdgeIterator<Edge>& operator ++()
+        {
+            current_ = next_;
+            if (current_ != end_)
+            {
+                target_ += ReadVarint(next_);
+            }
+            return *this;
+        }
+
+        DeltaEdgeIterator<Edge> operator ++(int dummy)
+        {
+            auto aCopy = *this;
+            ++*this;
+            return aCopy;
+        }
+
+        bool operator == (const DeltaEdgeIterator<Edge>& other) const
+        {
+            return current_ == other.current_;
+        }
+
+        bool operator != (const DeltaEdgeIterator<Edge>& other) const
+        {
+            return current_ != other.current_;
+        }
+
+    private:
+        TVertexDescriptor source_;
+        uint64_t target_;
+        const uint8_t* current_;
+        const uint8_t* next_;
+        const uint8_t* end_;
+    };
+
+    // Read-only graph whose out-neighbor lists are sorted and stored as
+    // varint gaps, so clustered ids (e.g. after BFS_ORDER reordering) cost
+    // one byte per edge, plus a 32-bit offset per vertex. Offers the same
+    // interface as CompressedSparseRowGraph, except that out-edges come
+    // back sorted by target and OutDegree() decodes the list's length.
+    template <typename VertexDescriptor, typename Edge>
+    class DeltaCompressedGraph
+    {
+        static_assert(std::is_integral<VertexDescriptor>::value,
+            "DeltaCompressedGraph requires integral vertex descriptors");
+
+    public:
+        using TVertexDescriptor = VertexDescriptor;
+        using TEdge = Edge;
+
+        using ConstVertexIterator = CountingIterator<TVertexDescriptor>;
+        using ConstEdgeIterator = DeltaEdgeIterator<TEdge>;
+
+        DeltaCompressedGraph()
+            : blockOffsets_(1, 0)
+            , offsets_(1, 0)
+            , bytes_()
+            , edgeCount_(0)
+        {}
+
+        template <typename TEdgeType>
+        explicit DeltaCompressedGraph(
+            const CompressedSparseRowGraph<TVertexDescriptor, TEdgeType>& graph)
+            : blockOffsets_(graph.VertexCount() / kBlockSize + 1, 0)
+            , offsets_(graph.VertexCount() + 1, 0)
+            , bytes_()
+            , edgeCount_(graph.EdgeCount())
+        {
+            const auto& sourceOffsets = graph.Offsets();
+            const auto& sourceTargets = graph.Targets();
+            size_t vertexCount = graph.VertexCount();
+            std::vector<uint64_t> targets;
+            for (size_t vertex = 0; vertex <= vertexCount; ++vertex)
+            {
+                size_t block = vertex / kBlockSize;
+                if (vertex % kBlockSize == 0)
+                {
+                    blockOffsets_[block] = bytes_.size();
+                }
+                if (bytes_.size() - blockOffsets_[block] > std::numeric_limits<uint32_t>::max())
+                {
+                    throw std::length_error("compressed lists of one vertex block exceed 4 GiB");
+                }
+                offsets_[vertex] = static_cast<uint32_t>(bytes_.size() - blockOffsets_[block]);
+                if (vertex == vertexCount)
+                {
+                    break;
+                }
+
+                targets.assign(sourceTargets.begin() + sourceOffsets[vertex],
+                    sourceTargets.begin() + sourceOffsets[vertex + 1]);
+                std::sort(targets.begin(), targets.end());
+                if (!targets.empty())
+                {
+                    int64_t delta = static_cast<int64_t>(targets[0]) -
+                        static_cast<int64_t>(vertex);
+                    AppendVarint(bytes_,
+                        (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+                }
+                for (size_t index = 1; index < targets.size(); ++index)
+                {
+                    AppendVarint(bytes_, targets[index] - targets[index - 1]);
+                }
+            }
+            bytes_.shrink_to_fit();
+        }
+
+        bool IsDirected() const
+        {
+            return true;
+        }
+
+        bool AllowParallelEdges() const
+        {
+            return true;
+        }
+
+        size_t VertexCount() const
+        {
+            return offsets_.size() - 1;
+        }
+
+        bool IsVerticesEmpty() const
+        {
+            return VertexCount() == 0;
+        }
+
+        IteratorRange<ConstVertexIterator> Vertices() const
+        {
+            return IteratorRange<ConstVertexIterator>(
+                ConstVertexIterator(0), ConstVertexIterator(VertexCount()));
+        }
+
+        bool ContainsVertex(const TVertexDescriptor& vertex) const
+        {
+            return !(vertex < TVertexDescriptor(0)) &&
+                static_cast<size_t>(vertex) < VertexCount();
+        }
+
+        bool IsOutEdgesEmpty(const TVertexDescriptor& vertex) const
+        {
+            auto index = static_cast<size_t>(vertex);
+            return ListStart(index) == ListStart(index + 1);
+        }
+
+        // Every varint ends in exactly one byte below 0x80
+        size_t OutDegree(const TVertexDescriptor& vertex) const
+        {
+            auto index = static_cast<size_t>(vertex);
+            return static_cast<size_t>(std::count_if(
+                bytes_.begin() + ListStart(index), bytes_.begin() + ListStart(index + 1),
+                [](uint8_t byte) { return byte < 0x80; }));
+        }
+
+        IteratorRange<ConstEdgeIterator> OutEdges(const TVertexDescriptor& vertex) const
+        {
+            auto index = static_cast<size_t>(vertex);
+            const uint8_t* begin = bytes_.data() + ListStart(index);
+            const uint8_t* end = bytes_.data() + ListStart(index + 1);
+            return IteratorRange<ConstEdgeIterator>(
+                ConstEdgeIterator(vertex, begin, end), ConstEdgeIterator(vertex, end, end));
+        }
+
+        bool TryGetEdges(const TVertexDescriptor& vertex,
+            IteratorRange<ConstEdgeIterator>& range) const
+        {
+            if (ContainsVertex(vertex))
+            {
+                range = OutEdges(vertex);
+                return true;
+            }
+            return false;
+        }
+
+        size_t EdgeCount() const
+        {
+            return edgeCount_;
+        }
+
+        List<TEdge> GetEdges() const
+        {
+            List<TEdge> edges;
+            for (const auto& vertex : Vertices())
+            {
+                for (const auto& edge : OutEdges(vertex))
+                {
+                    edges.push_back(edge);
+                }
+            }
+            return edges;
+        }
+
+        // Stops at the first target past the one looked for
+        bool ContainsEdge(const TVertexDescriptor& source,
+            const TVertexDescriptor& target) const
+        {
+            if (!ContainsVertex(source))
+            {
+                return false;
+            }
+            for (const auto& edge : OutEdges(source))
+            {
+                if (!(edge.Target() < target))
+                {
+                    return edge.Target() == target;
+                }
+            }
+            return false;
+        }
+
+        bool ContainsEdge(const TEdge& edge) const
+        {
+            return ContainsEdge(edge.Source(), edge.Target());
+        }
+
+        // Offsets and encoded lists
+        size_t ByteSize() const
+        {
+            return blockOffsets_.capacity() * sizeof(size_t) +
+                offsets_.capacity() * sizeof(uint32_t) + bytes_.capacity();
+        }
+
+    private:
+        // Vertices per absolute offset; within a block 32-bit offsets suffice
+        static constexpr size_t kBlockSize = 64;
+
+        size_t ListStart(size_t index) const
+        {
+            return blockOffsets_[index / kBlockSize] + offsets_[index];
+        }
+
+    private:
+        std::vector<size_t> blockOffsets_;
+        std::vector<uint32_t> offsets_;
+        std::vector<uint8_t> bytes_;
+        size_t edgeCount_;
+    };
+
+    template <typename VertexDescriptor, typename Edge>
+    struct DefaultPropertyMapSelector<DeltaCompressedGraph<VertexDescriptor, Edge>>
+    {
+        using type = VectorPropertyMapSelector;
+    };
+
+    template <typename VertexDescriptor, typename Edge>
+    struct DefaultContainerPolicy<DeltaCompressedGraph<VertexDescriptor, Edge>>
+    {
+        using type = FlatContainerPolicy;
+    };
+
+    // Compresses any graph with non-negative integral vertex descriptors,
+    // through a CSR copy (see MakeCompressedSparseRowGraph)
+    template <typename TGraph>
+    DeltaCompressedGraph<typename TGraph::TVertexDescriptor, typename TGraph::TEdge>
+        MakeDeltaCompressedGraph(const TGraph& graph)
+    {
+        return DeltaCompressedGraph<typename TGraph::TVertexDescriptor, typename TGraph::TEdge>(
+            MakeCompressedSparseRowGraph(graph));
+    }
+}
+
+#endif
\ No newline at end of file
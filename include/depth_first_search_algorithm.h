@@ -2,146 +2,230 @@
 #define STRONGLY_CONNECTED_COMPONENTS_DEPTH_FIRST_SEARCH_ALGORITHM_H_
 
 #include "graph_containers.h"
-#include "vertex_action.h"
-#include "edge_action.h"
+#include "depth_first_search_visitor.h"
 #include "graph_color.h"
+#include "property_map.h"
 #include "rooted_algorithm_base.h"
 
 namespace Graph
 {
     template <typename TGraph>
+    struct DepthFirstSearchFrame
+    {
+    public:
+        DepthFirstSearchFrame(const typename TGraph::TVertexDescriptor& vertex,
+            IteratorRange<typename TGraph::ConstEdgeIterator> edges)
+            : vertex(vertex)
+            , edges(edges)
+        {}
+
+        typename TGraph::TVertexDescriptor vertex;
+        IteratorRange<typename TGraph::ConstEdgeIterator> edges;
+    };
+
+    // Color map and frame stack of a search, kept across Compute calls and
+    // across graphs of the same type so repeated searches stop allocating
+    // once the storage has grown to the largest graph seen. With
+    // StampedPropertyMapSelector the colors are also cleared in O(1).
+    template <typename TGraph, typename TPropertyMapSelector =
+        typename DefaultPropertyMapSelector<TGraph>::type, typename TContainerPolicy =
+            typename DefaultContainerPolicy<TGraph>::type>
+    class DepthFirstSearchWorkspace
+    {
+    public:
+        using TColorMap = typename TPropertyMapSelector::template Map<
+            typename TGraph::TVertexDescriptor, GraphColor>;
+        using TFrameStack = typename TContainerPolicy::template Stack<
+            DepthFirstSearchFrame<TGraph>>;
+
+        DepthFirstSearchWorkspace()
+            : colors_()
+            , frames_()
+        {}
+
+        TColorMap& Colors()
+        {
+            return colors_;
+        }
+
+        const TColorMap& Colors() const
+        {
+            return colors_;
+        }
+
+        // Empty between searches
+        TFrameStack& Frames()
+        {
+            return frames_;
+        }
+
+    private:
+        TColorMap colors_;
+        TFrameStack frames_;
+    };
+
+    template <typename TGraph, typename TPropertyMapSelector =
+        typename DefaultPropertyMapSelector<TGraph>::type,
+        typename TVisitor = DepthFirstSearchActionVisitor<
+            typename TGraph::TVertexDescriptor, typename TGraph::TEdge>,
+        typename TStatistics = NoStatistics, typename TContainerPolicy =
+            typename DefaultContainerPolicy<TGraph>::type>
     class DepthFirstSearchAlgorithm :
-        public RootedAlgorithmBase<TGraph>
+        public RootedAlgorithmBase<TGraph, TStatistics>
     {
     public:
-        using BaseType = RootedAlgorithmBase<TGraph>;
+        using BaseType = RootedAlgorithmBase<TGraph, TStatistics>;
         using TVertexDescriptor = typename TGraph::TVertexDescriptor;
         using TEdge = typename TGraph::TEdge;
+        using TWorkspace = DepthFirstSearchWorkspace<TGraph, TPropertyMapSelector,
+            TContainerPolicy>;
+        using TColorMap = typename TWorkspace::TColorMap;
+
+        explicit DepthFirstSearchAlgorithm(const TGraph& graph,
+            TVisitor visitor = TVisitor())
+            : BaseType(graph)
+            , visitor_(visitor)
+            , ownWorkspace_()
+            , workspace_(nullptr)
+        {}
 
-        explicit DepthFirstSearchAlgorithm(const TGraph& graph)
+        // Borrows the storage of workspace, which must outlive the search;
+        // VertexColors() stays valid until the workspace is used again
+        DepthFirstSearchAlgorithm(const TGraph& graph, TWorkspace& workspace,
+            TVisitor visitor = TVisitor())
             : BaseType(graph)
-            , initializeVertexAction_()
-            , startVertexAction_()
-            , discoverVertexAction_()
-            , examineEdgeAction_()
-            , treeEdgeAction_()
-            , backEdgeAction_()
-            , forwardOrCrossEdgeAction_()
-            , finishVertexAction_()
-            , colors_()
+            , visitor_(visitor)
+            , ownWorkspace_()
+            , workspace_(&workspace)
         {}
 
-        std::shared_ptr<Dictionary<TVertexDescriptor, GraphColor>>
-            VertexColors() const
+        TVisitor& GetVisitor()
+        {
+            return visitor_;
+        }
+
+        const TVisitor& GetVisitor() const
         {
-                return colors_;
+            return visitor_;
+        }
+
+        const TColorMap& VertexColors() const
+        {
+            return GetWorkspace().Colors();
         }
 
         GraphColor GetVertexColor(const TVertexDescriptor& vertex) const
         {
-            return *colors_[vertex];
+            return VertexColors()[vertex];
         }
 
         template <typename TFunc>
         void SetInitializeVertexAction(TFunc action)
         {
-            initializeVertexAction_ = VertexAction<TVertexDescriptor>(action);
+            visitor_.SetInitializeVertexAction(VertexAction<TVertexDescriptor>(action));
         }
 
         void ResetInitializeVertexAction()
         {
-            initializeVertexAction_ = VertexAction<TVertexDescriptor>();
+            visitor_.SetInitializeVertexAction(VertexAction<TVertexDescriptor>());
         }
 
         template <typename TFunc>
         void SetStartVertexAction(TFunc action)
         {
-            startVertexAction_ = VertexAction<TVertexDescriptor>(action);
+            visitor_.SetStartVertexAction(VertexAction<TVertexDescriptor>(action));
         }
 
         void ResetStartVertexAction()
         {
-            startVertexAction_ = VertexAction<TVertexDescriptor>();
+            visitor_.SetStartVertexAction(VertexAction<TVertexDescriptor>());
         }
 
         template <typename TFunc>
         void SetDiscoverVertexAction(TFunc action)
         {
-            discoverVertexAction_ = VertexAction<TVertexDescriptor>(action);
+            visitor_.SetDiscoverVertexAction(VertexAction<TVertexDescriptor>(action));
         }
 
         void ResetDiscoverVertexAction()
         {
-            discoverVertexAction_ = VertexAction<TVertexDescriptor>();
+            visitor_.SetDiscoverVertexAction(VertexAction<TVertexDescriptor>());
         }
 
         template <typename TFunc>
         void SetExamineEdgeAction(TFunc action)
         {
-            examineEdgeAction_ = EdgeAction<TVertexDescriptor, TEdge>(action);
+            visitor_.SetExamineEdgeAction(EdgeAction<TVertexDescriptor, TEdge>(action));
         }
 
         void ResetExamineEdgeAction()
         {
-            examineEdgeAction_ = EdgeAction<TVertexDescriptor, TEdge>();
+            visitor_.SetExamineEdgeAction(EdgeAction<TVertexDescriptor, TEdge>());
         }
 
         template <typename TFunc>
         void SetTreeEdgeAction(TFunc action)
         {
-            treeEdgeAction_ = EdgeAction<TVertexDescriptor, TEdge>(action);
+            visitor_.SetTreeEdgeAction(EdgeAction<TVertexDescriptor, TEdge>(action));
         }
 
         void ResetTreeEdgeAction()
         {
-            treeEdgeAction_ = EdgeAction<TVertexDescriptor, TEdge>();
+            visitor_.SetTreeEdgeAction(EdgeAction<TVertexDescriptor, TEdge>());
         }
 
         template <typename TFunc>
         void SetBackEdgeAction(TFunc action)
         {
-            backEdgeAction_ = EdgeAction<TVertexDescriptor, TEdge>(action);
+            visitor_.SetBackEdgeAction(EdgeAction<TVertexDescriptor, TEdge>(action));
         }
 
         void ResetBackEdgeAction()
         {
-            backEdgeAction_ = EdgeAction<TVertexDescriptor, TEdge>();
+            visitor_.SetBackEdgeAction(EdgeAction<TVertexDescriptor, TEdge>());
         }
 
         template <typename TFunc>
         void SetForwardOrCrossEdgeAction(TFunc action)
         {
-            forwardOrCrossEdgeAction_ =
-                EdgeAction<TVertexDescriptor, TEdge>(action);
+            visitor_.SetForwardOrCrossEdgeAction(
+                EdgeAction<TVertexDescriptor, TEdge>(action));
         }
 
         void ResetForwardOrCrossEdgeAction()
         {
-            forwardOrCrossEdgeAction_ = EdgeAction<TVertexDescriptor, TEdge>();
+            visitor_.SetForwardOrCrossEdgeAction(
+                EdgeAction<TVertexDescriptor, TEdge>());
         }
 
         template <typename TFunc>
         void SetFinishVertexAction(TFunc action)
         {
-            finishVertexAction_ = VertexAction<TVertexDescriptor>(action);
+            visitor_.SetFinishVertexAction(VertexAction<TVertexDescriptor>(action));
         }
 
         void ResetFinishVertexAction()
         {
-            finishVertexAction_ = VertexAction<TVertexDescriptor>();
+            visitor_.SetFinishVertexAction(VertexAction<TVertexDescriptor>());
         }
 
     protected:
         void Initialize() override
         {
-            colors_ = std::make_shared < Dictionary < TVertexDescriptor,
-                GraphColor >> ();
-            auto& colors = *colors_.get();
+            auto& colors = GetWorkspace().Colors();
+            colors.Reset(BaseType::GetGraph());
+            // A search interrupted by an exception may have left frames
+            auto& frames = GetWorkspace().Frames();
+            while (!frames.empty())
+            {
+                frames.pop();
+            }
             for (const auto& vertex : BaseType::GetGraph().Vertices())
             {
                 colors[vertex] = GraphColor::WHITE;
-                initializeVertexAction_(vertex);
+                visitor_.InitializeVertex(vertex);
             }
+            BaseType::Statistics().ResultBytes(colors.ByteSize());
         }
 
         void InternalCompute() override
@@ -149,17 +233,17 @@ namespace Graph
             TVertexDescriptor root;
             if (BaseType::TryGetRoot(root))
             {
-                startVertexAction_(root);
+                visitor_.StartVertex(root);
                 Visit(root);
             }
             else
             {
-                auto& colors = *colors_.get();
+                const auto& colors = GetWorkspace().Colors();
                 for (const auto& vertex : BaseType::GetGraph().Vertices())
                 {
                     if (colors[vertex] == GraphColor::WHITE)
                     {
-                        startVertexAction_(vertex);
+                        visitor_.StartVertex(vertex);
                         Visit(vertex);
                     }
                 }
@@ -167,27 +251,29 @@ namespace Graph
         }
 
     private:
-        struct SearchFrame
+        using SearchFrame = DepthFirstSearchFrame<TGraph>;
+
+        TWorkspace& GetWorkspace()
         {
-        public:
-            SearchFrame(const TVertexDescriptor& vertex,
-                IteratorRange<typename TGraph::ConstEdgeIterator> edges)
-                : vertex(vertex)
-                , edges(edges)
-            {}
+            return workspace_ != nullptr ? *workspace_ : ownWorkspace_;
+        }
 
-            TVertexDescriptor vertex;
-            IteratorRange<typename TGraph::ConstEdgeIterator> edges;
-        };
+        const TWorkspace& GetWorkspace() const
+        {
+            return workspace_ != nullptr ? *workspace_ : ownWorkspace_;
+        }
 
         void Visit(const TVertexDescriptor& root)
         {
-            auto& colors = *colors_.get();
-            Stack<SearchFrame> todo;
+            auto& colors = GetWorkspace().Colors();
+            auto& statistics = BaseType::Statistics();
+            auto& todo = GetWorkspace().Frames();
             colors[root] = GraphColor::GRAY;
-            discoverVertexAction_(root);
+            statistics.DiscoverVertex();
+            visitor_.DiscoverVertex(root);
 
             todo.push(SearchFrame(root, BaseType::GetGraph().OutEdges(root)));
+            statistics.StackDepth(todo.size());
             while (!todo.empty())
             {
                 auto& frame = todo.top();
@@ -199,47 +285,48 @@ namespace Graph
                 while (edgesBegin != edgesEnd)
                 {
                     auto target = edgesBegin->Target();
-                    examineEdgeAction_(*edgesBegin);
+                    statistics.ExamineEdge();
+                    visitor_.ExamineEdge(*edgesBegin);
                     auto color = colors[target];
                     if (color == GraphColor::WHITE)
                     {
-                        treeEdgeAction_(*edgesBegin);
+                        statistics.TreeEdge();
+                        visitor_.TreeEdge(*edgesBegin);
                         todo.push(SearchFrame(vertex, IteratorRange < typename
                             TGraph::ConstEdgeIterator >(++edgesBegin, edgesEnd)));
+                        // The popped frame of the current vertex is live too
+                        statistics.StackDepth(todo.size() + 1);
                         vertex = target;
                         colors[vertex] = GraphColor::GRAY;
-                        discoverVertexAction_(vertex);
+                        statistics.DiscoverVertex();
+                        visitor_.DiscoverVertex(vertex);
                         auto newEdgeRange = BaseType::GetGraph().OutEdges(vertex);
                         edgesBegin = newEdgeRange.begin();
                         edgesEnd = newEdgeRange.end();
                     }
                     else if (color == GraphColor::GRAY)
                     {
-                        backEdgeAction_(*edgesBegin);
+                        statistics.BackEdge();
+                        visitor_.BackEdge(*edgesBegin);
                         ++edgesBegin;
                     }
                     else
                     {
-                        forwardOrCrossEdgeAction_(*edgesBegin);
+                        statistics.ForwardOrCrossEdge();
+                        visitor_.ForwardOrCrossEdge(*edgesBegin);
                         ++edgesBegin;
                     }
                 }
 
                 colors[vertex] = GraphColor::BLACK;
-                finishVertexAction_(vertex);
+                visitor_.FinishVertex(vertex);
             }
         }
 
     private:
-        VertexAction<TVertexDescriptor> initializeVertexAction_;
-        VertexAction<TVertexDescriptor> startVertexAction_;
-        VertexAction<TVertexDescriptor> discoverVertexAction_;
-        EdgeAction<TVertexDescriptor, TEdge> examineEdgeAction_;
-        EdgeAction<TVertexDescriptor, TEdge> treeEdgeAction_;
-        EdgeAction<TVertexDescriptor, TEdge> backEdgeAction_;
-        EdgeAction<TVertexDescriptor, TEdge> forwardOrCrossEdgeAction_;
-        VertexAction<TVertexDescriptor> finishVertexAction_;
-        std::shared_ptr<Dictionary<TVertexDescriptor, GraphColor>> colors_;
+        TVisitor visitor_;
+        TWorkspace ownWorkspace_;
+        TWorkspace* workspace_;
     };
 }
 
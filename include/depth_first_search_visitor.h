@@ -0,0 +1,160 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_DEPTH_FIRST_SEARCH_VISITOR_H_
+#define STRONGLY_CONNECTED_COMPONENTS_DEPTH_FIRST_SEARCH_VISITOR_H_
+
+#include "vertex_action.h"
+#include "edge_action.h"
+
+namespace Graph
+{
+    // Event hooks of DepthFirstSearchAlgorithm, resolved at compile time.
+    // Derive from this and hide the hooks you need; the rest stay empty and
+    // are inlined away.
+    class DepthFirstSearchVisitor
+    {
+    public:
+        template <typename TVertexDescriptor>
+        void InitializeVertex(const TVertexDescriptor& vertex)
+        {}
+
+        template <typename TVertexDescriptor>
+        void StartVertex(const TVertexDescriptor& vertex)
+        {}
+
+        template <typename TVertexDescriptor>
+        void DiscoverVertex(const TVertexDescriptor& vertex)
+        {}
+
+        template <typename TEdge>
+        void ExamineEdge(const TEdge& edge)
+        {}
+
+        template <typename TEdge>
+        void TreeEdge(const TEdge& edge)
+        {}
+
+        template <typename TEdge>
+        void BackEdge(const TEdge& edge)
+        {}
+
+        template <typename TEdge>
+        void ForwardOrCrossEdge(const TEdge& edge)
+        {}
+
+        template <typename TVertexDescriptor>
+        void FinishVertex(const TVertexDescriptor& vertex)
+        {}
+    };
+
+    // Visitor that forwards every event to a replaceable run-time action.
+    // Backs the Set*Action interface of DepthFirstSearchAlgorithm.
+    template <typename VertexDescriptor, typename Edge>
+    class DepthFirstSearchActionVisitor
+    {
+    public:
+        using TVertexDescriptor = VertexDescriptor;
+        using TEdge = Edge;
+
+        DepthFirstSearchActionVisitor()
+            : initializeVertexAction_()
+            , startVertexAction_()
+            , discoverVertexAction_()
+            , examineEdgeAction_()
+            , treeEdgeAction_()
+            , backEdgeAction_()
+            , forwardOrCrossEdgeAction_()
+            , finishVertexAction_()
+        {}
+
+        void InitializeVertex(const TVertexDescriptor& vertex)
+        {
+            initializeVertexAction_(vertex);
+        }
+
+        void StartVertex(const TVertexDescriptor& vertex)
+        {
+            startVertexAction_(vertex);
+        }
+
+        void DiscoverVertex(const TVertexDescriptor& vertex)
+        {
+            discoverVertexAction_(vertex);
+        }
+
+        void ExamineEdge(const TEdge& edge)
+        {
+            examineEdgeAction_(edge);
+        }
+
+        void TreeEdge(const TEdge& edge)
+        {
+            treeEdgeAction_(edge);
+        }
+
+        void BackEdge(const TEdge& edge)
+        {
+            backEdgeAction_(edge);
+        }
+
+        void ForwardOrCrossEdge(const TEdge& edge)
+        {
+            forwardOrCrossEdgeAction_(edge);
+        }
+
+        void FinishVertex(const TVertexDescriptor& vertex)
+        {
+            finishVertexAction_(vertex);
+        }
+
+        void SetInitializeVertexAction(VertexAction<TVertexDescriptor> action)
+        {
+            initializeVertexAction_ = action;
+        }
+
+        void SetStartVertexAction(VertexAction<TVertexDescriptor> action)
+        {
+            startVertexAction_ = action;
+        }
+
+        void SetDiscoverVertexAction(VertexAction<TVertexDescriptor> action)
+        {
+            discoverVertexAction_ = action;
+        }
+
+        void SetExamineEdgeAction(EdgeAction<TVertexDescriptor, TEdge> action)
+        {
+            examineEdgeAction_ = action;
+        }
+
+        void SetTreeEdgeAction(EdgeAction<TVertexDescriptor, TEdge> action)
+        {
+            treeEdgeAction_ = action;
+        }
+
+        void SetBackEdgeAction(EdgeAction<TVertexDescriptor, TEdge> action)
+        {
+            backEdgeAction_ = action;
+        }
+
+        void SetForwardOrCrossEdgeAction(EdgeAction<TVertexDescriptor, TEdge> action)
+        {
+            forwardOrCrossEdgeAction_ = action;
+        }
+
+        void SetFinishVertexAction(VertexAction<TVertexDescriptor> action)
+        {
+            finishVertexAction_ = action;
+        }
+
+    private:
+        VertexAction<TVertexDescriptor> initializeVertexAction_;
+        VertexAction<TVertexDescriptor> startVertexAction_;
+        VertexAction<TVertexDescriptor> discoverVertexAction_;
+        EdgeAction<TVertexDescriptor, TEdge> examineEdgeAction_;
+        EdgeAction<TVertexDescriptor, TEdge> treeEdgeAction_;
+        EdgeAction<TVertexDescriptor, TEdge> backEdgeAction_;
+        EdgeAction<TVertexDescriptor, TEdge> forwardOrCrossEdgeAction_;
+        VertexAction<TVertexDescriptor> finishVertexAction_;
+    };
+}
+
+#endif
\ No newline at end of file
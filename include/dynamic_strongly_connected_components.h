@@ -0,0 +1,655 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_DYNAMIC_STRONGLY_CONNECTED_COMPONENTS_H_
+#define STRONGLY_CONNECTED_COMPONENTS_DYNAMIC_STRONGLY_CONNECTED_COMPONENTS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "graph_containers.h"
+#include "pearce_strongly_connected_component_algorithm.h"
+
+namespace Graph
+{
+    // Keeps the strongly connected components of a graph, and a topological
+    // order of its condensation, up to date while vertices and edges are
+    // inserted and removed. Subscribes to the graph's notifications.
+    //
+    // Insertions: an edge that agrees with the current order costs O(1).
+    // Otherwise the order is repaired as in Pearce and Kelly's dynamic
+    // topological sort: only components whose order lies between the edge's
+    // endpoints are searched, and when the forward search reaches back to
+    // the source the components on the new cycle are merged into one, in the
+    // spirit of Haeupler et al.
+    //
+    // Deletions: only an edge inside a component can change anything. The
+    // component is kept if the edge's source still reaches its target inside
+    // it; otherwise it alone is re-decomposed and its pieces take its place
+    // in the order. The largest piece keeps the component id.
+    //
+    // Component ids are slots that stay stable until the component is merged
+    // or split away; they are not dense.
+    template <typename TGraph>
+    class DynamicStronglyConnectedComponents
+    {
+    public:
+        using TVertexDescriptor = typename TGraph::TVertexDescriptor;
+        using TEdge = typename TGraph::TEdge;
+
+        static constexpr size_t kNoComponent = std::numeric_limits<size_t>::max();
+
+        explicit DynamicStronglyConnectedComponents(TGraph& graph)
+            : graph_(graph)
+            , indices_()
+            , vertices_()
+            , freeVertices_()
+            , successors_()
+            , predecessors_()
+            , componentOf_()
+            , vertexMarks_()
+            , localIndices_()
+            , components_()
+            , freeComponents_()
+            , componentsCount_(0)
+            , orderIndex_()
+            , forwardMarks_()
+            , backwardMarks_()
+            , epoch_(0)
+        {
+            Build();
+            graph_.SetVertexAddedAction(
+                [this](const TVertexDescriptor& vertex) { InsertVertex(vertex); });
+            graph_.SetEdgeAddedAction(
+                [this](const TEdge& edge) { InsertEdge(edge); });
+            graph_.SetVertexRemovedAction(
+                [this](const TVertexDescriptor& vertex) { RemoveVertex(vertex); });
+            graph_.SetEdgeRemovedAction(
+                [this](const TEdge& edge) { RemoveEdge(edge); });
+        }
+
+        DynamicStronglyConnectedComponents(
+            const DynamicStronglyConnectedComponents&) = delete;
+        DynamicStronglyConnectedComponents& operator=(
+            const DynamicStronglyConnectedComponents&) = delete;
+
+        ~DynamicStronglyConnectedComponents()
+        {
+            graph_.ResetVertexAddedAction();
+            graph_.ResetEdgeAddedAction();
+            graph_.ResetVertexRemovedAction();
+            graph_.ResetEdgeRemovedAction();
+        }
+
+        size_t GetComponentsCount() const
+        {
+            return componentsCount_;
+        }
+
+        // kNoComponent for a vertex the graph does not hold
+        size_t GetComponent(const TVertexDescriptor& vertex) const
+        {
+            auto iindex = indices_.find(vertex);
+            return iindex != indices_.end() ? componentOf_[iindex->second] : kNoComponent;
+        }
+
+        std::vector<TVertexDescriptor> GetComponentMembers(size_t component) const
+        {
+            std::vector<TVertexDescriptor> members;
+            for (auto index : components_[component].members)
+            {
+                members.push_back(vertices_[index]);
+            }
+            return members;
+        }
+
+        // Component ids ordered so that every inter-component edge points
+        // forward
+        std::vector<size_t> GetTopologicalOrder() const
+        {
+            std::vector<size_t> order;
+            order.reserve(componentsCount_);
+            for (const auto& orderComponentPair : orderIndex_)
+            {
+                order.push_back(orderComponentPair.second);
+            }
+            return order;
+        }
+
+        // Entry points of the graph notifications; also usable directly when
+        // the graph is modified elsewhere.
+        void InsertVertex(const TVertexDescriptor& vertex)
+        {
+            EnsureVertex(vertex);
+        }
+
+        void InsertEdge(const TEdge& edge)
+        {
+            size_t source = EnsureVertex(edge.Source());
+            size_t target = EnsureVertex(edge.Target());
+            successors_[source].push_back(target);
+            predecessors_[target].push_back(source);
+
+            size_t sourceComponent = componentOf_[source];
+            size_t targetComponent = componentOf_[target];
+            if (sourceComponent != targetComponent &&
+                components_[targetComponent].order < components_[sourceComponent].order)
+            {
+                Reorder(sourceComponent, targetComponent);
+            }
+        }
+
+        void RemoveEdge(const TEdge& edge)
+        {
+            auto isource = indices_.find(edge.Source());
+            auto itarget = indices_.find(edge.Target());
+            if (isource != indices_.end() && itarget != indices_.end())
+            {
+                RemoveArc(isource->second, itarget->second);
+            }
+        }
+
+        void RemoveVertex(const TVertexDescriptor& vertex)
+        {
+            auto iindex = indices_.find(vertex);
+            if (iindex == indices_.end())
+            {
+                return;
+            }
+            size_t index = iindex->second;
+            // Incident edges are normally reported before the vertex
+            while (!successors_[index].empty())
+            {
+                RemoveArc(index, successors_[index].back());
+            }
+            while (!predecessors_[index].empty())
+            {
+                RemoveArc(predecessors_[index].back(), index);
+            }
+            ReleaseComponent(componentOf_[index]);
+            indices_.erase(iindex);
+            freeVertices_.push_back(index);
+        }
+
+    private:
+        struct Component
+        {
+            std::vector<size_t> members;
+            size_t order;
+            bool alive;
+        };
+
+        // Orders are spread out so that a split component usually finds room
+        // for its pieces next to its old position
+        static constexpr size_t kOrderGap = size_t(1) << 16;
+
+        void Build()
+        {
+            PearceStronglyConnectedComponentAlgorithm<TGraph> scc(graph_);
+            scc.Compute();
+            const auto& sccComponents = scc.GetComponents();
+
+            // Components come out in reverse topological order
+            size_t count = scc.GetComponentsCount();
+            for (size_t component = 0; component < count; ++component)
+            {
+                NewComponent((count - component) * kOrderGap);
+            }
+            for (const auto& vertex : graph_.Vertices())
+            {
+                AddIndex(vertex, sccComponents[vertex]);
+            }
+            for (const auto& vertex : graph_.Vertices())
+            {
+                size_t source = indices_[vertex];
+                for (const auto& edge : graph_.OutEdges(vertex))
+                {
+                    size_t target = EnsureVertex(edge.Target());
+                    successors_[source].push_back(target);
+                    predecessors_[target].push_back(source);
+                }
+            }
+        }
+
+        size_t NewComponent(size_t order)
+        {
+            size_t component = 0;
+            if (!freeComponents_.empty())
+            {
+                component = freeComponents_.back();
+                freeComponents_.pop_back();
+            }
+            else
+            {
+                component = components_.size();
+                components_.push_back(Component());
+                forwardMarks_.push_back(0);
+                backwardMarks_.push_back(0);
+            }
+            components_[component].members.clear();
+            components_[component].alive = true;
+            SetOrder(component, order);
+            ++componentsCount_;
+            return component;
+        }
+
+        void ReleaseComponent(size_t component)
+        {
+            orderIndex_.erase(components_[component].order);
+            components_[component].members = std::vector<size_t>();
+            components_[component].alive = false;
+            freeComponents_.push_back(component);
+            --componentsCount_;
+        }
+
+        void SetOrder(size_t component, size_t order)
+        {
+            components_[component].order = order;
+            orderIndex_[order] = component;
+        }
+
+        size_t AddIndex(const TVertexDescriptor& vertex, size_t component)
+        {
+            size_t index = vertices_.size();
+            if (!freeVertices_.empty())
+            {
+                index = freeVertices_.back();
+                freeVertices_.pop_back();
+                vertices_[index] = vertex;
+                componentOf_[index] = component;
+            }
+            else
+            {
+                vertices_.push_back(vertex);
+                successors_.push_back(std::vector<size_t>());
+                predecessors_.push_back(std::vector<size_t>());
+                componentOf_.push_back(component);
+                vertexMarks_.push_back(0);
+                localIndices_.push_back(0);
+            }
+            indices_[vertex] = index;
+            components_[component].members.push_back(index);
+            return index;
+        }
+
+        size_t EnsureVertex(const TVertexDescriptor& vertex)
+        {
+            auto iindex = indices_.find(vertex);
+            if (iindex != indices_.end())
+            {
+                return iindex->second;
+            }
+            size_t order = orderIndex_.empty() ?
+                kOrderGap :
+                orderIndex_.rbegin()->first + kOrderGap;
+            return AddIndex(vertex, NewComponent(order));
+        }
+
+        // Edge sourceComponent -> targetComponent contradicts the order
+        void Reorder(size_t sourceComponent, size_t targetComponent)
+        {
+            size_t lowerBound = components_[targetComponent].order;
+            size_t upperBound = components_[sourceComponent].order;
+            ++epoch_;
+            auto forward = Search(targetComponent, successors_, forwardMarks_,
+                [upperBound](size_t order) { return order <= upperBound; });
+            auto backward = Search(sourceComponent, predecessors_, backwardMarks_,
+                [lowerBound](size_t order) { return order >= lowerBound; });
+
+            // Components reached by both searches lie on a cycle through the
+            // new edge; there are none unless the source was reached forward
+            std::vector<size_t> positions;
+            std::vector<size_t> before;
+            std::vector<size_t> cycle;
+            std::vector<size_t> after;
+            for (auto component : backward)
+            {
+                positions.push_back(components_[component].order);
+                if (forwardMarks_[component] == epoch_)
+                {
+                    cycle.push_back(component);
+                }
+                else
+                {
+                    before.push_back(component);
+                }
+            }
+            for (auto component : forward)
+            {
+                if (backwardMarks_[component] != epoch_)
+                {
+                    positions.push_back(components_[component].order);
+                    after.push_back(component);
+                }
+            }
+
+            auto byOrder = [this](size_t left, size_t right)
+            {
+                return components_[left].order < components_[right].order;
+            };
+            std::sort(positions.begin(), positions.end());
+            std::sort(before.begin(), before.end(), byOrder);
+            std::sort(after.begin(), after.end(), byOrder);
+            for (auto position : positions)
+            {
+                orderIndex_.erase(position);
+            }
+
+            // Predecessors only move down and successors only move up, so
+            // components outside the searched region stay consistent
+            for (size_t position = 0; position < before.size(); ++position)
+            {
+                SetOrder(before[position], positions[position]);
+            }
+            size_t firstAfter = positions.size() - after.size();
+            for (size_t position = 0; position < after.size(); ++position)
+            {
+                SetOrder(after[position], positions[firstAfter + position]);
+            }
+            if (!cycle.empty())
+            {
+                SetOrder(Merge(cycle), positions[before.size()]);
+            }
+        }
+
+        template <typename TInRange>
+        std::vector<size_t> Search(size_t start,
+            const std::vector<std::vector<size_t>>& adjacency,
+            std::vector<size_t>& marks, TInRange inRange)
+        {
+            std::vector<size_t> visited(1, start);
+            marks[start] = epoch_;
+            for (size_t position = 0; position < visited.size(); ++position)
+            {
+                for (auto member : components_[visited[position]].members)
+                {
+                    for (auto next : adjacency[member])
+                    {
+                        size_t component = componentOf_[next];
+                        if (marks[component] != epoch_ &&
+                            inRange(components_[component].order))
+                        {
+                            marks[component] = epoch_;
+                            visited.push_back(component);
+                        }
+                    }
+                }
+            }
+            return visited;
+        }
+
+        // Folds the smaller components into the largest one
+        size_t Merge(const std::vector<size_t>& cycle)
+        {
+            size_t survivor = cycle.front();
+            for (auto component : cycle)
+            {
+                if (components_[component].members.size() >
+                    components_[survivor].members.size())
+                {
+                    survivor = component;
+                }
+            }
+            for (auto component : cycle)
+            {
+                if (component == survivor)
+                {
+                    continue;
+                }
+                for (auto member : components_[component].members)
+                {
+                    componentOf_[member] = survivor;
+                    components_[survivor].members.push_back(member);
+                }
+                components_[component].members = std::vector<size_t>();
+                components_[component].alive = false;
+                freeComponents_.push_back(component);
+                --componentsCount_;
+            }
+            return survivor;
+        }
+
+        static void EraseOne(std::vector<size_t>& arcs, size_t value)
+        {
+            auto iarc = std::find(arcs.begin(), arcs.end(), value);
+            if (iarc != arcs.end())
+            {
+                *iarc = arcs.back();
+                arcs.pop_back();
+            }
+        }
+
+        void RemoveArc(size_t source, size_t target)
+        {
+            EraseOne(successors_[source], target);
+            EraseOne(predecessors_[target], source);
+            size_t component = componentOf_[source];
+            if (component == componentOf_[target] &&
+                !ReachesInside(source, target, component))
+            {
+                Split(component);
+            }
+        }
+
+        bool ReachesInside(size_t source, size_t target, size_t component)
+        {
+            if (source == target)
+            {
+                return true;
+            }
+            ++epoch_;
+            std::vector<size_t> todo(1, source);
+            vertexMarks_[source] = epoch_;
+            while (!todo.empty())
+            {
+                size_t vertex = todo.back();
+                todo.pop_back();
+                for (auto next : successors_[vertex])
+                {
+                    if (next == target)
+                    {
+                        return true;
+                    }
+                    if (componentOf_[next] == component && vertexMarks_[next] != epoch_)
+                    {
+                        vertexMarks_[next] = epoch_;
+                        todo.push_back(next);
+                    }
+                }
+            }
+            return false;
+        }
+
+        // Re-decomposes one component with Pearce's algorithm restricted to
+        // its members and gives the pieces consecutive orders in its place
+        void Split(size_t component)
+        {
+            std::vector<size_t> members;
+            members.swap(components_[component].members);
+            std::vector<size_t> pieceOf;
+            size_t piecesCount = DecomposeInside(component, members, pieceOf);
+
+            std::vector<std::vector<size_t>> pieces(piecesCount);
+            for (size_t local = 0; local < members.size(); ++local)
+            {
+                pieces[pieceOf[local]].push_back(members[local]);
+            }
+            size_t largest = 0;
+            for (size_t piece = 0; piece < piecesCount; ++piece)
+            {
+                if (pieces[piece].size() > pieces[largest].size())
+                {
+                    largest = piece;
+                }
+            }
+
+            size_t lower = 0;
+            size_t upper = 0;
+            FindRoom(component, piecesCount, lower, upper);
+            orderIndex_.erase(components_[component].order);
+            size_t step = (upper - lower) / (piecesCount + 1);
+
+            // Pieces are numbered in reverse topological order
+            for (size_t piece = 0; piece < piecesCount; ++piece)
+            {
+                size_t order = lower + step * (piecesCount - piece);
+                size_t pieceComponent = component;
+                if (piece == largest)
+                {
+                    SetOrder(component, order);
+                }
+                else
+                {
+                    pieceComponent = NewComponent(order);
+                }
+                for (auto member : pieces[piece])
+                {
+                    componentOf_[member] = pieceComponent;
+                }
+                components_[pieceComponent].members.swap(pieces[piece]);
+            }
+        }
+
+        // Finds the free interval (lower, upper) around the component's order,
+        // spreading all orders out again when it is too narrow
+        void FindRoom(size_t component, size_t piecesCount, size_t& lower, size_t& upper)
+        {
+            while (true)
+            {
+                auto iorder = orderIndex_.find(components_[component].order);
+                lower = iorder == orderIndex_.begin() ? 0 : std::prev(iorder)->first;
+                auto inext = std::next(iorder);
+                upper = inext == orderIndex_.end() ?
+                    iorder->first + kOrderGap * piecesCount :
+                    inext->first;
+                if (upper - lower > piecesCount)
+                {
+                    return;
+                }
+                Renumber(component, piecesCount);
+            }
+        }
+
+        // Spaces orders kOrderGap apart, but the splitting component gets at
+        // least piecesCount + 1 free orders on either side, so one pass
+        // always makes room however many pieces there are
+        void Renumber(size_t component, size_t piecesCount)
+        {
+            size_t wideGap = std::max(kOrderGap, piecesCount + 1);
+            OrderedDictionary<size_t, size_t> renumbered;
+            size_t order = 0;
+            bool afterComponent = false;
+            for (const auto& orderComponentPair : orderIndex_)
+            {
+                bool isComponent = orderComponentPair.second == component;
+                order += isComponent || afterComponent ? wideGap : kOrderGap;
+                afterComponent = isComponent;
+                components_[orderComponentPair.second].order = order;
+                renumbered[order] = orderComponentPair.second;
+            }
+            orderIndex_.swap(renumbered);
+        }
+
+        size_t DecomposeInside(size_t component, const std::vector<size_t>& members,
+            std::vector<size_t>& pieceOf)
+        {
+            struct Frame
+            {
+                size_t vertex;
+                size_t arc;
+                bool isRoot;
+            };
+
+            size_t count = members.size();
+            for (size_t local = 0; local < count; ++local)
+            {
+                localIndices_[members[local]] = local;
+            }
+            std::vector<size_t> rindex(count, 0);
+            std::vector<size_t> finished;
+            std::vector<Frame> frames;
+            size_t index = 1;
+            size_t slot = count - 1;
+            for (size_t root = 0; root < count; ++root)
+            {
+                if (rindex[root] != 0)
+                {
+                    continue;
+                }
+                rindex[root] = index++;
+                frames.push_back(Frame{ root, 0, true });
+                while (!frames.empty())
+                {
+                    size_t vertex = frames.back().vertex;
+                    const auto& arcs = successors_[members[vertex]];
+                    if (frames.back().arc == arcs.size())
+                    {
+                        bool isRoot = frames.back().isRoot;
+                        frames.pop_back();
+                        if (!isRoot)
+                        {
+                            finished.push_back(vertex);
+                            continue;
+                        }
+                        --index;
+                        while (!finished.empty() && rindex[vertex] <= rindex[finished.back()])
+                        {
+                            rindex[finished.back()] = slot;
+                            finished.pop_back();
+                            --index;
+                        }
+                        rindex[vertex] = slot--;
+                        continue;
+                    }
+
+                    size_t next = arcs[frames.back().arc];
+                    if (componentOf_[next] != component)
+                    {
+                        ++frames.back().arc;
+                        continue;
+                    }
+                    size_t localNext = localIndices_[next];
+                    if (rindex[localNext] == 0)
+                    {
+                        rindex[localNext] = index++;
+                        frames.push_back(Frame{ localNext, 0, true });
+                        continue;
+                    }
+                    if (rindex[localNext] < rindex[vertex])
+                    {
+                        rindex[vertex] = rindex[localNext];
+                        frames.back().isRoot = false;
+                    }
+                    ++frames.back().arc;
+                }
+            }
+
+            pieceOf.resize(count);
+            for (size_t local = 0; local < count; ++local)
+            {
+                pieceOf[local] = count - 1 - rindex[local];
+            }
+            return count - 1 - slot;
+        }
+
+    private:
+        TGraph& graph_;
+        Dictionary<TVertexDescriptor, size_t> indices_;
+        std::vector<TVertexDescriptor> vertices_;
+        std::vector<size_t> freeVertices_;
+        std::vector<std::vector<size_t>> successors_;
+        std::vector<std::vector<size_t>> predecessors_;
+        std::vector<size_t> componentOf_;
+        std::vector<size_t> vertexMarks_;
+        std::vector<size_t> localIndices_;
+        std::vector<Component> components_;
+        std::vector<size_t> freeComponents_;
+        size_t componentsCount_;
+        OrderedDictionary<size_t, size_t> orderIndex_;
+        std::vector<size_t> forwardMarks_;
+        std::vector<size_t> backwardMarks_;
+        size_t epoch_;
+    };
+}
+
+#endif
\ No newline at end of file
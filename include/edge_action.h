@@ -29,6 +29,11 @@ namespace Graph
             }
         }
 
+        explicit operator bool() const
+        {
+            return static_cast<bool>(action_);
+        }
+
     private:
         std::function<void(const TEdge&)> action_;
     };
@@ -0,0 +1,254 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_EDGE_LIST_READER_H_
+#define STRONGLY_CONNECTED_COMPONENTS_EDGE_LIST_READER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "edge.h"
+#include "compressed_sparse_row_graph.h"
+#include "mapped_file.h"
+#include "work_stealing_thread_pool.h"
+
+namespace Graph
+{
+    // Loads text edge lists: one "source target" pair of non-negative
+    // integers per line, separated by spaces or tabs. Blank lines and
+    // everything from '#' to the end of a line are ignored, as are extra
+    // columns such as weights.
+    //
+    // The file is memory-mapped and cut into newline-aligned chunks that
+    // are scanned in parallel; the per-chunk buffers are then laid out into
+    // a CompressedSparseRowGraph in one pass, keeping the input order of the
+    // out-edges of every vertex.
+    template <typename VertexDescriptor>
+    class EdgeListReader
+    {
+        static_assert(std::is_integral<VertexDescriptor>::value,
+            "EdgeListReader requires integral vertex descriptors");
+
+    public:
+        using TVertexDescriptor = VertexDescriptor;
+        using TEdge = Edge<TVertexDescriptor>;
+        using TGraph = CompressedSparseRowGraph<TVertexDescriptor, TEdge>;
+
+        static constexpr size_t kDefaultMinChunkSize = size_t(1) << 20;
+
+        // threadCount == 0 uses every hardware thread. Inputs smaller than
+        // two chunks are scanned on the calling thread.
+        explicit EdgeListReader(size_t threadCount = 0,
+            size_t minChunkSize = kDefaultMinChunkSize)
+            : threadCount_(threadCount)
+            , minChunkSize_(std::max<size_t>(1, minChunkSize))
+        {}
+
+        TGraph Read(const std::string& path) const
+        {
+            MappedFile file(path);
+            file.AdviseSequential();
+            return Parse(file.Data(), file.Data() + file.Size());
+        }
+
+        TGraph Parse(const char* begin, const char* end) const
+        {
+            std::vector<Chunk> chunks = Split(begin, end);
+            if (chunks.size() == 1)
+            {
+                Scan(begin, chunks.front());
+            }
+            else
+            {
+                WorkStealingThreadPool pool(threadCount_);
+                TaskGroup group(pool);
+                for (auto& chunk : chunks)
+                {
+                    Chunk* target = &chunk;
+                    group.Run([begin, target]() { Scan(begin, *target); });
+                }
+                group.Wait();
+            }
+            return Build(chunks);
+        }
+
+    private:
+        struct Chunk
+        {
+            const char* begin;
+            const char* end;
+            // Sources and targets interleaved
+            std::vector<TVertexDescriptor> endpoints;
+            size_t vertexBound;
+        };
+
+        std::vector<Chunk> Split(const char* begin, const char* end) const
+        {
+            size_t size = static_cast<size_t>(end - begin);
+            size_t threadCount = threadCount_ == 0 ?
+                std::max<size_t>(1, std::thread::hardware_concurrency()) : threadCount_;
+            size_t chunkCount = std::max<size_t>(1,
+                std::min(4 * threadCount, size / minChunkSize_));
+
+            std::vector<Chunk> chunks;
+            const char* chunkBegin = begin;
+            for (size_t index = 1; index <= chunkCount && chunkBegin < end; ++index)
+            {
+                const char* chunkEnd = index == chunkCount ?
+                    end : begin + size / chunkCount * index;
+                chunkEnd = std::max(chunkEnd, chunkBegin);
+                while (chunkEnd < end && chunkEnd[-1] != '\n')
+                {
+                    ++chunkEnd;
+                }
+                chunks.push_back(Chunk{ chunkBegin, chunkEnd, {}, 0 });
+                chunkBegin = chunkEnd;
+            }
+            if (chunks.empty())
+            {
+                chunks.push_back(Chunk{ begin, end, {}, 0 });
+            }
+            return chunks;
+        }
+
+        static bool IsBlank(char symbol)
+        {
+            return symbol == ' ' || symbol == '\t' || symbol == '\r';
+        }
+
+        static void SkipLine(const char*& position, const char* end)
+        {
+            while (position < end && *position != '\n')
+            {
+                ++position;
+            }
+        }
+
+        [[noreturn]] static void Fail(const char* base, const char* position)
+        {
+            throw std::runtime_error("malformed edge list at byte " +
+                std::to_string(position - base));
+        }
+
+        static TVertexDescriptor ScanVertex(const char*& position, const char* end,
+            const char* base)
+        {
+            while (position < end && IsBlank(*position))
+            {
+                ++position;
+            }
+            if (position == end || *position < '0' || *position > '9')
+            {
+                Fail(base, position);
+            }
+            const uint64_t limit = static_cast<uint64_t>(
+                std::numeric_limits<TVertexDescriptor>::max());
+            uint64_t value = 0;
+            while (position < end && *position >= '0' && *position <= '9')
+            {
+                uint64_t digit = static_cast<uint64_t>(*position - '0');
+                // Checked before multiplying, as a 64-bit value would wrap
+                if (value > (limit - digit) / 10)
+                {
+                    Fail(base, position);
+                }
+                value = value * 10 + digit;
+                ++position;
+            }
+            return static_cast<TVertexDescriptor>(value);
+        }
+
+        static void Scan(const char* base, Chunk& chunk)
+        {
+            const char* position = chunk.begin;
+            const char* end = chunk.end;
+            uint64_t largest = 0;
+            bool any = false;
+            while (position < end)
+            {
+                char symbol = *position;
+                if (symbol == '\n' || IsBlank(symbol))
+                {
+                    ++position;
+                    continue;
+                }
+                if (symbol == '#')
+                {
+                    SkipLine(position, end);
+                    continue;
+                }
+                TVertexDescriptor source = ScanVertex(position, end, base);
+                if (position < end && !IsBlank(*position))
+                {
+                    Fail(base, position);
+                }
+                TVertexDescriptor target = ScanVertex(position, end, base);
+                if (position < end && !IsBlank(*position) && *position != '\n' &&
+                    *position != '#')
+                {
+                    Fail(base, position);
+                }
+                SkipLine(position, end);
+
+                chunk.endpoints.push_back(source);
+                chunk.endpoints.push_back(target);
+                largest = std::max<uint64_t>(largest,
+                    std::max<uint64_t>(source, target));
+                any = true;
+            }
+            chunk.vertexBound = any ? static_cast<size_t>(largest) + 1 : 0;
+        }
+
+        static TGraph Build(std::vector<Chunk>& chunks)
+        {
+            size_t vertexCount = 0;
+            for (const auto& chunk : chunks)
+            {
+                vertexCount = std::max(vertexCount, chunk.vertexBound);
+            }
+            std::vector<size_t> offsets(vertexCount + 1, 0);
+            for (const auto& chunk : chunks)
+            {
+                for (size_t edge = 0; edge < chunk.endpoints.size(); edge += 2)
+                {
+                    ++offsets[static_cast<size_t>(chunk.endpoints[edge]) + 1];
+                }
+            }
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                offsets[vertex + 1] += offsets[vertex];
+            }
+            std::vector<TVertexDescriptor> targets(offsets[vertexCount]);
+            std::vector<size_t> positions(offsets.begin(), offsets.end() - 1);
+            for (auto& chunk : chunks)
+            {
+                for (size_t edge = 0; edge < chunk.endpoints.size(); edge += 2)
+                {
+                    targets[positions[static_cast<size_t>(chunk.endpoints[edge])]++] =
+                        chunk.endpoints[edge + 1];
+                }
+                chunk.endpoints = std::vector<TVertexDescriptor>();
+            }
+            return TGraph(std::move(offsets), std::move(targets));
+        }
+
+    private:
+        size_t threadCount_;
+        size_t minChunkSize_;
+    };
+
+    template <typename TVertexDescriptor>
+    CompressedSparseRowGraph<TVertexDescriptor, Edge<TVertexDescriptor>> ReadEdgeList(
+        const std::string& path, size_t threadCount = 0)
+    {
+        return EdgeListReader<TVertexDescriptor>(threadCount).Read(path);
+    }
+}
+
+#endif
\ No newline at end of file
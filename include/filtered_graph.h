@@ -0,0 +1,160 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_FILTERED_GRAPH_H_
+#define STRONGLY_CONNECTED_COMPONENTS_FILTERED_GRAPH_H_
+
+#include <cstddef>
+
+#include "iterator_tools.h"
+#include "property_map.h"
+
+namespace Graph
+{
+    // Read-only view of the subgraph induced by the vertices a predicate
+    // accepts. Nothing is copied; rejected vertices and every edge leading
+    // to them are skipped during iteration.
+    template <typename TGraph, typename TVertexPredicate>
+    class FilteredGraph
+    {
+    public:
+        using TVertexDescriptor = typename TGraph::TVertexDescriptor;
+        using TEdge = typename TGraph::TEdge;
+
+        class TargetPredicate
+        {
+        public:
+            TargetPredicate()
+                : pred_()
+            {}
+
+            explicit TargetPredicate(TVertexPredicate pred)
+                : pred_(pred)
+            {}
+
+            bool operator()(const TEdge& edge) const
+            {
+                return pred_(edge.Target());
+            }
+
+        private:
+            TVertexPredicate pred_;
+        };
+
+        using ConstVertexIterator = FilterIterator<
+            typename TGraph::ConstVertexIterator, TVertexPredicate>;
+        using ConstEdgeIterator = FilterIterator<
+            typename TGraph::ConstEdgeIterator, TargetPredicate>;
+
+        FilteredGraph(const TGraph& graph, TVertexPredicate pred)
+            : graph_(graph)
+            , pred_(pred)
+        {}
+
+        const TGraph& GetUnderlyingGraph() const
+        {
+            return graph_;
+        }
+
+        bool IsDirected() const
+        {
+            return graph_.IsDirected();
+        }
+
+        bool AllowParallelEdges() const
+        {
+            return graph_.AllowParallelEdges();
+        }
+
+        // Linear in the size of the underlying graph
+        size_t VertexCount() const
+        {
+            size_t count = 0;
+            for (auto ivertex = Vertices().begin(); ivertex != Vertices().end(); ++ivertex)
+            {
+                ++count;
+            }
+            return count;
+        }
+
+        bool IsVerticesEmpty() const
+        {
+            return Vertices().begin() == Vertices().end();
+        }
+
+        IteratorRange<ConstVertexIterator> Vertices() const
+        {
+            return MakeFilteredRange(graph_.Vertices(), pred_);
+        }
+
+        bool ContainsVertex(const TVertexDescriptor& vertex) const
+        {
+            return graph_.ContainsVertex(vertex) && pred_(vertex);
+        }
+
+        bool IsOutEdgesEmpty(const TVertexDescriptor& vertex) const
+        {
+            return OutEdges(vertex).begin() == OutEdges(vertex).end();
+        }
+
+        size_t OutDegree(const TVertexDescriptor& vertex) const
+        {
+            size_t degree = 0;
+            for (auto iedge = OutEdges(vertex).begin(); iedge != OutEdges(vertex).end(); ++iedge)
+            {
+                ++degree;
+            }
+            return degree;
+        }
+
+        IteratorRange<ConstEdgeIterator> OutEdges(const TVertexDescriptor& vertex) const
+        {
+            return MakeFilteredRange(graph_.OutEdges(vertex), TargetPredicate(pred_));
+        }
+
+        bool TryGetEdges(const TVertexDescriptor& vertex,
+            IteratorRange<ConstEdgeIterator>& range) const
+        {
+            if (ContainsVertex(vertex))
+            {
+                range = OutEdges(vertex);
+                return true;
+            }
+            return false;
+        }
+
+        bool ContainsEdge(const TVertexDescriptor& source,
+            const TVertexDescriptor& target) const
+        {
+            return ContainsVertex(source) && ContainsVertex(target) &&
+                graph_.ContainsEdge(source, target);
+        }
+
+        bool ContainsEdge(const TEdge& edge) const
+        {
+            return ContainsEdge(edge.Source(), edge.Target());
+        }
+
+    private:
+        const TGraph& graph_;
+        TVertexPredicate pred_;
+    };
+
+    template <typename TGraph, typename TVertexPredicate>
+    struct DefaultPropertyMapSelector<FilteredGraph<TGraph, TVertexPredicate>>
+    {
+        using type = typename DefaultPropertyMapSelector<TGraph>::type;
+    };
+
+    template <typename TGraph, typename TVertexPredicate>
+    struct DefaultContainerPolicy<FilteredGraph<TGraph, TVertexPredicate>>
+    {
+        using type = typename DefaultContainerPolicy<TGraph>::type;
+    };
+
+    template <typename TGraph, typename TVertexPredicate>
+    FilteredGraph<TGraph, TVertexPredicate> MakeFilteredGraph(
+        const TGraph& graph, TVertexPredicate pred)
+    {
+        return FilteredGraph<TGraph, TVertexPredicate>(graph, pred);
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,387 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_FLAT_HASH_MAP_H_
+#define STRONGLY_CONNECTED_COMPONENTS_FLAT_HASH_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Graph
+{
+    // Open-addressing hash map with linear probing over one flat array.
+    // Erase shifts the following entries of a probe run back instead of
+    // leaving tombstones, so lookups never slow down after removals. Keys
+    // and values must be default constructible; pointers returned by Find
+    // and Insert are invalidated by the next Insert or Erase.
+    //
+    // The lower-case members mirror the subset of std::unordered_map the
+    // graphs and property maps use, so the map can serve as the Dictionary
+    // of a container policy. Iterators are invalidated like the pointers,
+    // and entries must not be erased while iterating.
+    template <typename Key, typename Value, typename Hash = std::hash<Key>>
+    class FlatHashMap
+    {
+    private:
+        template <bool IsConst>
+        class BasicIterator;
+
+    public:
+        using TKey = Key;
+        using TValue = Value;
+
+        using key_type = TKey;
+        using mapped_type = TValue;
+        using value_type = std::pair<TKey, TValue>;
+        using size_type = size_t;
+        using allocator_type = std::allocator<value_type>;
+        using iterator = BasicIterator<false>;
+        using const_iterator = BasicIterator<true>;
+
+        FlatHashMap()
+            : slots_()
+            , used_()
+            , size_(0)
+            , mask_(0)
+            , hash_()
+        {}
+
+        size_t Size() const
+        {
+            return size_;
+        }
+
+        bool IsEmpty() const
+        {
+            return size_ == 0;
+        }
+
+        void Clear()
+        {
+            slots_.clear();
+            used_.clear();
+            size_ = 0;
+            mask_ = 0;
+        }
+
+        // Makes room for count entries without rehashing
+        void Reserve(size_t count)
+        {
+            size_t capacity = kMinCapacity;
+            while (capacity * kMaxLoadNumerator < count * kMaxLoadDenominator)
+            {
+                capacity *= 2;
+            }
+            if (capacity > slots_.size())
+            {
+                Rehash(capacity);
+            }
+        }
+
+        TValue* Find(const TKey& key)
+        {
+            size_t slot = 0;
+            return Locate(key, slot) ? &slots_[slot].second : nullptr;
+        }
+
+        const TValue* Find(const TKey& key) const
+        {
+            size_t slot = 0;
+            return Locate(key, slot) ? &slots_[slot].second : nullptr;
+        }
+
+        bool Contains(const TKey& key) const
+        {
+            return Find(key) != nullptr;
+        }
+
+        // Returns the value stored under key and whether it was inserted now
+        std::pair<TValue*, bool> Insert(const TKey& key, const TValue& value)
+        {
+            auto result = try_emplace(key, value);
+            return std::make_pair(&result.first->second, result.second);
+        }
+
+        TValue& operator[](const TKey& key)
+        {
+            return *Insert(key, TValue()).first;
+        }
+
+        bool Erase(const TKey& key)
+        {
+            size_t hole = 0;
+            if (!Locate(key, hole))
+            {
+                return false;
+            }
+            // Pull back every later entry of the run whose home slot does not
+            // lie strictly between the hole and its current slot
+            for (size_t slot = (hole + 1) & mask_; used_[slot]; slot = (slot + 1) & mask_)
+            {
+                size_t home = HomeSlot(slots_[slot].first);
+                if (((slot - home) & mask_) >= ((slot - hole) & mask_))
+                {
+                    slots_[hole] = std::move(slots_[slot]);
+                    hole = slot;
+                }
+            }
+            slots_[hole] = std::pair<TKey, TValue>();
+            used_[hole] = 0;
+            --size_;
+            return true;
+        }
+
+        // Visits every entry as func(key, value) in unspecified order
+        template <typename TFunc>
+        void ForEach(TFunc func) const
+        {
+            for (size_t slot = 0; slot < slots_.size(); ++slot)
+            {
+                if (used_[slot])
+                {
+                    func(slots_[slot].first, slots_[slot].second);
+                }
+            }
+        }
+
+        // Slots and occupancy flags, empty ones included
+        size_t ByteSize() const
+        {
+            return slots_.capacity() * sizeof(value_type) + used_.capacity();
+        }
+
+        size_t size() const
+        {
+            return size_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        void clear()
+        {
+            Clear();
+        }
+
+        void reserve(size_t count)
+        {
+            Reserve(count);
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator_type();
+        }
+
+        iterator begin()
+        {
+            return iterator(this, 0);
+        }
+
+        iterator end()
+        {
+            return iterator(this, slots_.size());
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, slots_.size());
+        }
+
+        iterator find(const TKey& key)
+        {
+            size_t slot = 0;
+            return Locate(key, slot) ? iterator(this, slot) : end();
+        }
+
+        const_iterator find(const TKey& key) const
+        {
+            size_t slot = 0;
+            return Locate(key, slot) ? const_iterator(this, slot) : end();
+        }
+
+        size_t count(const TKey& key) const
+        {
+            return Contains(key) ? 1 : 0;
+        }
+
+        // Grows only when key is actually new
+        template <typename... TArgs>
+        std::pair<iterator, bool> try_emplace(const TKey& key, TArgs&&... args)
+        {
+            size_t slot = 0;
+            if (Locate(key, slot))
+            {
+                return std::make_pair(iterator(this, slot), false);
+            }
+            if ((size_ + 1) * kMaxLoadDenominator > slots_.size() * kMaxLoadNumerator)
+            {
+                Rehash(slots_.empty() ? kMinCapacity : 2 * slots_.size());
+                Locate(key, slot);
+            }
+            slots_[slot] = value_type(key, TValue(std::forward<TArgs>(args)...));
+            used_[slot] = 1;
+            ++size_;
+            return std::make_pair(iterator(this, slot), true);
+        }
+
+        size_t erase(const TKey& key)
+        {
+            return Erase(key) ? 1 : 0;
+        }
+
+    private:
+        template <bool IsConst>
+        class BasicIterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename FlatHashMap::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = typename std::conditional<IsConst,
+                const value_type&, value_type&>::type;
+            using pointer = typename std::conditional<IsConst,
+                const value_type*, value_type*>::type;
+            using TMap = typename std::conditional<IsConst,
+                const FlatHashMap, FlatHashMap>::type;
+
+            BasicIterator()
+                : map_(nullptr)
+                , slot_(0)
+            {}
+
+            BasicIterator(TMap* map, size_t slot)
+                : map_(map)
+                , slot_(slot)
+            {
+                SkipEmpty();
+            }
+
+            // iterator converts to const_iterator
+            template <bool OtherConst, typename = typename std::enable_if<
+                IsConst && !OtherConst>::type>
+            BasicIterator(const BasicIterator<OtherConst>& other)
+                : map_(other.map_)
+                , slot_(other.slot_)
+            {}
+
+            reference operator*() const
+            {
+                return map_->slots_[slot_];
+            }
+
+            pointer operator->() const
+            {
+                return &map_->slots_[slot_];
+            }
+
+            BasicIterator& operator++()
+            {
+                ++slot_;
+                SkipEmpty();
+                return *this;
+            }
+
+            BasicIterator operator++(int)
+            {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(const BasicIterator& other) const
+            {
+                return slot_ == other.slot_ && map_ == other.map_;
+            }
+
+            bool operator!=(const BasicIterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            friend class BasicIterator<!IsConst>;
+
+            void SkipEmpty()
+            {
+                while (slot_ < map_->slots_.size() && !map_->used_[slot_])
+                {
+                    ++slot_;
+                }
+            }
+
+        private:
+            TMap* map_;
+            size_t slot_;
+        };
+
+        static constexpr size_t kMinCapacity = 8;
+        static constexpr size_t kMaxLoadNumerator = 1;
+        static constexpr size_t kMaxLoadDenominator = 2;
+
+        // std::hash is the identity for integers, so spread the bits first
+        size_t HomeSlot(const TKey& key) const
+        {
+            uint64_t hash = static_cast<uint64_t>(hash_(key));
+            hash *= 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(hash ^ (hash >> 32)) & mask_;
+        }
+
+        // Finds the slot holding key, or the empty slot where it belongs
+        bool Locate(const TKey& key, size_t& slot) const
+        {
+            if (slots_.empty())
+            {
+                return false;
+            }
+            for (slot = HomeSlot(key); used_[slot]; slot = (slot + 1) & mask_)
+            {
+                if (slots_[slot].first == key)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void Rehash(size_t capacity)
+        {
+            std::vector<std::pair<TKey, TValue>> slots(capacity);
+            std::vector<unsigned char> used(capacity, 0);
+            slots.swap(slots_);
+            used.swap(used_);
+            mask_ = capacity - 1;
+            size_ = 0;
+            for (size_t slot = 0; slot < slots.size(); ++slot)
+            {
+                if (used[slot])
+                {
+                    size_t target = 0;
+                    Locate(slots[slot].first, target);
+                    slots_[target] = std::move(slots[slot]);
+                    used_[target] = 1;
+                    ++size_;
+                }
+            }
+        }
+
+    private:
+        std::vector<std::pair<TKey, TValue>> slots_;
+        std::vector<unsigned char> used_;
+        size_t size_;
+        size_t mask_;
+        Hash hash_;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,470 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_FORWARD_BACKWARD_STRONGLY_CONNECTED_COMPONENT_ALGORITHM_H_
+#define STRONGLY_CONNECTED_COMPONENTS_FORWARD_BACKWARD_STRONGLY_CONNECTED_COMPONENT_ALGORITHM_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "edge.h"
+#include "property_map.h"
+#include "vertex_index_map.h"
+#include "compressed_sparse_row_graph.h"
+#include "work_stealing_thread_pool.h"
+#include "algorithm_base.h"
+
+namespace Graph
+{
+    // Parallel Forward-Backward-Trim decomposition. Each task owns one
+    // partition of the vertices: it peels vertices without in- or out-edges
+    // inside the partition, picks a pivot, and marks its forward and backward
+    // reachable sets. Their intersection is the pivot's component; the
+    // forward-only, backward-only and unreached vertices become three new
+    // independent tasks on a work-stealing pool. Reachability fans out over
+    // the pool as well once a BFS frontier is large enough. Partitions that
+    // are small, or that a pivot barely shrank (many tiny components, where
+    // pivoting alone is quadratic), finish with a serial Tarjan pass.
+    //
+    // Component ids are dense but, unlike the DFS based algorithms, are not
+    // in topological order and depend on thread scheduling.
+    template <typename TGraph, typename TPropertyMapSelector =
+        typename DefaultPropertyMapSelector<TGraph>::type>
+    class ForwardBackwardStronglyConnectedComponentAlgorithm :
+        public AlgorithmBase<TGraph>
+    {
+    public:
+        using BaseType = AlgorithmBase<TGraph>;
+        using TVertexDescriptor = typename TGraph::TVertexDescriptor;
+        using TEdge = typename TGraph::TEdge;
+        using TComponentMap = typename TPropertyMapSelector::template Map<
+            TVertexDescriptor, size_t>;
+
+        // threadCount == 0 uses every hardware thread
+        explicit ForwardBackwardStronglyConnectedComponentAlgorithm(
+            const TGraph& graph, size_t threadCount = 0)
+            : BaseType(graph)
+            , threadCount_(threadCount)
+            , components_()
+            , componentsCount_(0)
+            , forward_()
+            , backward_()
+            , colors_()
+            , inDegrees_()
+            , outDegrees_()
+            , componentOf_()
+            , nextColor_(0)
+            , nextComponent_(0)
+            , pool_(nullptr)
+            , group_(nullptr)
+        {}
+
+        void SetThreadCount(size_t threadCount)
+        {
+            threadCount_ = threadCount;
+        }
+
+        const TComponentMap& GetComponents() const
+        {
+            return components_;
+        }
+
+        size_t GetComponentsCount() const
+        {
+            return componentsCount_;
+        }
+
+    protected:
+        void Initialize() override
+        {
+            const auto& graph = BaseType::GetGraph();
+            components_.Reset(graph);
+            componentsCount_ = 0;
+            nextColor_ = 1;
+            nextComponent_ = 0;
+        }
+
+        void InternalCompute() override
+        {
+            const auto& graph = BaseType::GetGraph();
+            VertexIndexMap<TGraph, TPropertyMapSelector> indices(graph);
+            forward_ = MakeCompressedSparseRowGraph(graph, indices);
+            backward_ = MakeTransposedGraph(forward_);
+
+            size_t vertexCount = indices.VertexCount();
+            colors_.reset(new std::atomic<size_t>[vertexCount]);
+            std::vector<size_t> members(vertexCount);
+            for (size_t index = 0; index < vertexCount; ++index)
+            {
+                colors_[index].store(0, std::memory_order_relaxed);
+                members[index] = index;
+            }
+            inDegrees_.assign(vertexCount, 0);
+            outDegrees_.assign(vertexCount, 0);
+            componentOf_.assign(vertexCount, 0);
+
+            WorkStealingThreadPool pool(threadCount_);
+            TaskGroup group(pool);
+            pool_ = &pool;
+            group_ = &group;
+            Spawn(0, std::move(members));
+            group.Wait();
+            pool_ = nullptr;
+            group_ = nullptr;
+
+            for (size_t index = 0; index < vertexCount; ++index)
+            {
+                components_[indices.VertexAt(index)] = componentOf_[index];
+            }
+            componentsCount_ = nextComponent_;
+        }
+
+        void Clear() override
+        {
+            forward_ = IndexGraph();
+            backward_ = IndexGraph();
+            colors_.reset();
+            inDegrees_ = std::vector<size_t>();
+            outDegrees_ = std::vector<size_t>();
+            componentOf_ = std::vector<size_t>();
+        }
+
+    private:
+        using IndexGraph = CompressedSparseRowGraph<size_t, Edge<size_t>>;
+
+        static constexpr size_t kParallelGrain = 1024;
+        // A pivot step that settles less than 1/kStallRatio of its partition
+        // hands the unreached rest to DecomposeSerially
+        static constexpr size_t kStallRatio = 64;
+        static constexpr size_t kNoColor = std::numeric_limits<size_t>::max();
+        static constexpr size_t kDoneColor = std::numeric_limits<size_t>::max() - 1;
+
+        void Spawn(size_t color, std::vector<size_t> members)
+        {
+            auto task = std::make_shared<std::vector<size_t>>(std::move(members));
+            group_->Run([this, color, task]() { Decompose(color, *task); });
+        }
+
+        void Decompose(size_t color, std::vector<size_t>& members)
+        {
+            Trim(color, members);
+            if (members.empty())
+            {
+                return;
+            }
+            if (members.size() < kParallelGrain)
+            {
+                DecomposeSerially(color, members);
+                return;
+            }
+
+            size_t forwardColor = nextColor_.fetch_add(3);
+            size_t backwardColor = forwardColor + 1;
+            size_t componentColor = forwardColor + 2;
+            size_t pivot = members[PickPivot(forwardColor, members.size())];
+
+            colors_[pivot].store(forwardColor, std::memory_order_relaxed);
+            Reach(forward_, pivot, color, forwardColor, kNoColor, kNoColor);
+            colors_[pivot].store(componentColor, std::memory_order_relaxed);
+            Reach(backward_, pivot, color, backwardColor, forwardColor, componentColor);
+
+            size_t component = nextComponent_.fetch_add(1);
+            std::vector<size_t> forwardMembers;
+            std::vector<size_t> backwardMembers;
+            std::vector<size_t> otherMembers;
+            for (auto vertex : members)
+            {
+                size_t vertexColor = colors_[vertex].load(std::memory_order_relaxed);
+                if (vertexColor == componentColor)
+                {
+                    componentOf_[vertex] = component;
+                    colors_[vertex].store(kDoneColor, std::memory_order_relaxed);
+                }
+                else if (vertexColor == forwardColor)
+                {
+                    forwardMembers.push_back(vertex);
+                }
+                else if (vertexColor == backwardColor)
+                {
+                    backwardMembers.push_back(vertex);
+                }
+                else
+                {
+                    otherMembers.push_back(vertex);
+                }
+            }
+            size_t memberCount = members.size();
+            members = std::vector<size_t>();
+
+            if (!forwardMembers.empty())
+            {
+                Spawn(forwardColor, std::move(forwardMembers));
+            }
+            if (!backwardMembers.empty())
+            {
+                Spawn(backwardColor, std::move(backwardMembers));
+            }
+            if (otherMembers.empty())
+            {
+                return;
+            }
+            if ((memberCount - otherMembers.size()) * kStallRatio < memberCount)
+            {
+                auto task = std::make_shared<std::vector<size_t>>(std::move(otherMembers));
+                group_->Run([this, color, task]() { DecomposeSerially(color, *task); });
+            }
+            else
+            {
+                Spawn(color, std::move(otherMembers));
+            }
+        }
+
+        // Iterative Tarjan restricted to one partition. The partition owns
+        // its vertices' degree slots, so they hold discover times (0 means
+        // unvisited) and low links. Visited vertices still of this color are
+        // exactly the ones on the Tarjan stack.
+        void DecomposeSerially(size_t color, const std::vector<size_t>& members)
+        {
+            auto& discoverTimes = inDegrees_;
+            auto& lowLinks = outDegrees_;
+            for (auto vertex : members)
+            {
+                discoverTimes[vertex] = 0;
+            }
+            const auto& offsets = forward_.Offsets();
+            const auto& targets = forward_.Targets();
+            size_t time = 0;
+            std::vector<std::pair<size_t, size_t>> frames;
+            std::vector<size_t> stack;
+            for (auto root : members)
+            {
+                if (discoverTimes[root] != 0 ||
+                    colors_[root].load(std::memory_order_relaxed) != color)
+                {
+                    continue;
+                }
+                discoverTimes[root] = lowLinks[root] = ++time;
+                stack.push_back(root);
+                frames.emplace_back(root, offsets[root]);
+                while (!frames.empty())
+                {
+                    size_t vertex = frames.back().first;
+                    size_t& edge = frames.back().second;
+                    if (edge < offsets[vertex + 1])
+                    {
+                        size_t next = targets[edge++];
+                        if (colors_[next].load(std::memory_order_relaxed) != color)
+                        {
+                            continue;
+                        }
+                        if (discoverTimes[next] == 0)
+                        {
+                            discoverTimes[next] = lowLinks[next] = ++time;
+                            stack.push_back(next);
+                            frames.emplace_back(next, offsets[next]);
+                        }
+                        else if (discoverTimes[next] < lowLinks[vertex])
+                        {
+                            lowLinks[vertex] = discoverTimes[next];
+                        }
+                        continue;
+                    }
+                    frames.pop_back();
+                    if (!frames.empty() && lowLinks[vertex] < lowLinks[frames.back().first])
+                    {
+                        lowLinks[frames.back().first] = lowLinks[vertex];
+                    }
+                    if (lowLinks[vertex] == discoverTimes[vertex])
+                    {
+                        size_t component = nextComponent_.fetch_add(1);
+                        size_t member;
+                        do
+                        {
+                            member = stack.back();
+                            stack.pop_back();
+                            componentOf_[member] = component;
+                            colors_[member].store(kDoneColor, std::memory_order_relaxed);
+                        } while (member != vertex);
+                    }
+                }
+            }
+        }
+
+        // Pseudo-random but reproducible position. A fixed position degrades
+        // to one component per level on chains of cycles, making the whole
+        // decomposition quadratic.
+        static size_t PickPivot(size_t seed, size_t count)
+        {
+            uint64_t mixed = static_cast<uint64_t>(seed) + 0x9E3779B97F4A7C15ull;
+            mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+            mixed ^= mixed >> 31;
+            return static_cast<size_t>(mixed % count);
+        }
+
+        // Peels vertices with no in- or no out-neighbor inside the partition
+        // (self-loops ignored); each one is a component of its own.
+        void Trim(size_t color, std::vector<size_t>& members)
+        {
+            ParallelFor(*pool_, 0, members.size(), kParallelGrain,
+                [this, color, &members](size_t begin, size_t end)
+            {
+                for (size_t position = begin; position < end; ++position)
+                {
+                    size_t vertex = members[position];
+                    inDegrees_[vertex] = CountNeighbors(backward_, vertex, color);
+                    outDegrees_[vertex] = CountNeighbors(forward_, vertex, color);
+                }
+            });
+
+            std::vector<size_t> worklist;
+            for (auto vertex : members)
+            {
+                if (inDegrees_[vertex] == 0 || outDegrees_[vertex] == 0)
+                {
+                    colors_[vertex].store(kDoneColor, std::memory_order_relaxed);
+                    worklist.push_back(vertex);
+                }
+            }
+            while (!worklist.empty())
+            {
+                size_t vertex = worklist.back();
+                worklist.pop_back();
+                componentOf_[vertex] = nextComponent_.fetch_add(1);
+                Unlink(forward_, vertex, color, inDegrees_, worklist);
+                Unlink(backward_, vertex, color, outDegrees_, worklist);
+            }
+
+            size_t kept = 0;
+            for (auto vertex : members)
+            {
+                if (colors_[vertex].load(std::memory_order_relaxed) == color)
+                {
+                    members[kept++] = vertex;
+                }
+            }
+            members.resize(kept);
+        }
+
+        size_t CountNeighbors(const IndexGraph& graph, size_t vertex, size_t color) const
+        {
+            const auto& offsets = graph.Offsets();
+            const auto& targets = graph.Targets();
+            size_t count = 0;
+            for (size_t edge = offsets[vertex]; edge < offsets[vertex + 1]; ++edge)
+            {
+                size_t next = targets[edge];
+                if (next != vertex &&
+                    colors_[next].load(std::memory_order_relaxed) == color)
+                {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        void Unlink(const IndexGraph& graph, size_t vertex, size_t color,
+            std::vector<size_t>& degrees, std::vector<size_t>& worklist)
+        {
+            const auto& offsets = graph.Offsets();
+            const auto& targets = graph.Targets();
+            for (size_t edge = offsets[vertex]; edge < offsets[vertex + 1]; ++edge)
+            {
+                size_t next = targets[edge];
+                if (next != vertex &&
+                    colors_[next].load(std::memory_order_relaxed) == color &&
+                    --degrees[next] == 0)
+                {
+                    colors_[next].store(kDoneColor, std::memory_order_relaxed);
+                    worklist.push_back(next);
+                }
+            }
+        }
+
+        // Level-synchronous BFS from pivot. A vertex is claimed by atomically
+        // recoloring it fromColor -> toColor (or otherFromColor -> otherToColor),
+        // so every vertex enters the frontier once even when levels are
+        // expanded by several threads.
+        void Reach(const IndexGraph& graph, size_t pivot,
+            size_t fromColor, size_t toColor,
+            size_t otherFromColor, size_t otherToColor)
+        {
+            const auto& offsets = graph.Offsets();
+            const auto& targets = graph.Targets();
+            auto expand = [&](size_t vertex, std::vector<size_t>& next)
+            {
+                for (size_t edge = offsets[vertex]; edge < offsets[vertex + 1]; ++edge)
+                {
+                    size_t target = targets[edge];
+                    if (Claim(target, fromColor, toColor) ||
+                        Claim(target, otherFromColor, otherToColor))
+                    {
+                        next.push_back(target);
+                    }
+                }
+            };
+
+            std::vector<size_t> frontier(1, pivot);
+            std::vector<size_t> next;
+            std::mutex nextMutex;
+            while (!frontier.empty())
+            {
+                next.clear();
+                if (frontier.size() < kParallelGrain)
+                {
+                    for (auto vertex : frontier)
+                    {
+                        expand(vertex, next);
+                    }
+                }
+                else
+                {
+                    ParallelFor(*pool_, 0, frontier.size(), kParallelGrain,
+                        [&](size_t begin, size_t end)
+                    {
+                        std::vector<size_t> local;
+                        for (size_t position = begin; position < end; ++position)
+                        {
+                            expand(frontier[position], local);
+                        }
+                        std::lock_guard<std::mutex> lock(nextMutex);
+                        next.insert(next.end(), local.begin(), local.end());
+                    });
+                }
+                frontier.swap(next);
+            }
+        }
+
+        bool Claim(size_t vertex, size_t fromColor, size_t toColor)
+        {
+            if (fromColor == kNoColor)
+            {
+                return false;
+            }
+            size_t expected = fromColor;
+            return colors_[vertex].load(std::memory_order_relaxed) == fromColor &&
+                colors_[vertex].compare_exchange_strong(expected, toColor,
+                    std::memory_order_relaxed);
+        }
+
+    private:
+        size_t threadCount_;
+        TComponentMap components_;
+        size_t componentsCount_;
+        IndexGraph forward_;
+        IndexGraph backward_;
+        std::unique_ptr<std::atomic<size_t>[]> colors_;
+        std::vector<size_t> inDegrees_;
+        std::vector<size_t> outDegrees_;
+        std::vector<size_t> componentOf_;
+        std::atomic<size_t> nextColor_;
+        std::atomic<size_t> nextComponent_;
+        WorkStealingThreadPool* pool_;
+        TaskGroup* group_;
+    };
+}
+
+#endif
\ No newline at end of file
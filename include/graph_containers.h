@@ -1,20 +1,111 @@
 #ifndef STRONGLY_CONNECTED_COMPONENTS_GRAPH_CONTAINERS_H_
 #define STRONGLY_CONNECTED_COMPONENTS_GRAPH_CONTAINERS_H_
 
+#include <deque>
+#include <functional>
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <map>
 #include <list>
 #include <stack>
+#include <utility>
+#include <vector>
+
+#include "flat_hash_map.h"
+#include "node_pool.h"
 
 namespace Graph
 {
-    template <typename TKey, typename TValue>
-    using Dictionary = std::unordered_map<TKey, TValue>;
+    // Allocator policies pick where container nodes live. Standard uses the
+    // heap node by node; Pool draws from the NodePool of the scope open when
+    // the container was constructed (see NodePool::Scope).
+    struct StandardAllocatorPolicy
+    {
+        template <typename T>
+        using Allocator = std::allocator<T>;
+    };
 
-    template <typename TValue>
-    using List = std::list<TValue>;
+    struct PoolAllocatorPolicy
+    {
+        template <typename T>
+        using Allocator = PoolAllocator<T>;
+    };
+
+    template <typename TKey, typename TValue,
+        typename TAllocatorPolicy = StandardAllocatorPolicy>
+    using Dictionary = std::unordered_map<TKey, TValue, std::hash<TKey>,
+        std::equal_to<TKey>,
+        typename TAllocatorPolicy::template Allocator<std::pair<const TKey, TValue>>>;
+
+    template <typename TKey, typename TValue,
+        typename TAllocatorPolicy = StandardAllocatorPolicy>
+    using OrderedDictionary = std::map<TKey, TValue, std::less<TKey>,
+        typename TAllocatorPolicy::template Allocator<std::pair<const TKey, TValue>>>;
+
+    template <typename TValue, typename TAllocatorPolicy = StandardAllocatorPolicy>
+    using HashSet = std::unordered_set<TValue, std::hash<TValue>, std::equal_to<TValue>,
+        typename TAllocatorPolicy::template Allocator<TValue>>;
+
+    template <typename TValue, typename TAllocatorPolicy = StandardAllocatorPolicy>
+    using List = std::list<TValue, typename TAllocatorPolicy::template Allocator<TValue>>;
+
+    template <typename TValue, typename TAllocatorPolicy = StandardAllocatorPolicy>
+    using Stack = std::stack<TValue,
+        std::deque<TValue, typename TAllocatorPolicy::template Allocator<TValue>>>;
 
     template <typename TValue>
-    using Stack = std::stack<TValue>;
+    using VectorStack = std::stack<TValue, std::vector<TValue>>;
+
+    // Container policies pick the layout of a graph and of the algorithms
+    // run on it: Dictionary holds the vertex table and hashed result maps,
+    // EdgeList the out-edges of one vertex, Stack the search stacks.
+    //
+    // Node containers keep iterators stable across insertions and make
+    // removal O(1); that is what the membership index of AdjacencyGraph
+    // relies on.
+    template <typename TAllocatorPolicy = StandardAllocatorPolicy>
+    struct NodeContainerPolicy
+    {
+        static constexpr bool kStableEdgeIterators = true;
+
+        template <typename TKey, typename TValue>
+        using Dictionary = Graph::Dictionary<TKey, TValue, TAllocatorPolicy>;
+
+        template <typename TValue>
+        using EdgeList = List<TValue, TAllocatorPolicy>;
+
+        template <typename TValue>
+        using Stack = Graph::Stack<TValue, TAllocatorPolicy>;
+    };
+
+    using StandardContainerPolicy = NodeContainerPolicy<>;
+
+    using PoolContainerPolicy = NodeContainerPolicy<PoolAllocatorPolicy>;
+
+    // Contiguous layout for traversal-heavy workloads: open-addressing maps
+    // with integer-friendly hashing, vector out-edges and vector stacks.
+    // Removing an edge costs O(out-degree) and there is no membership index.
+    struct FlatContainerPolicy
+    {
+        static constexpr bool kStableEdgeIterators = false;
+
+        template <typename TKey, typename TValue>
+        using Dictionary = FlatHashMap<TKey, TValue>;
+
+        template <typename TValue>
+        using EdgeList = std::vector<TValue>;
+
+        template <typename TValue>
+        using Stack = VectorStack<TValue>;
+    };
+
+    // Graphs specialize this to the policy their algorithms should follow
+    template <typename TGraph>
+    struct DefaultContainerPolicy
+    {
+        using type = StandardContainerPolicy;
+    };
 }
 
 #endif
\ No newline at end of file
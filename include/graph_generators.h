@@ -0,0 +1,345 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_GRAPH_GENERATORS_H_
+#define STRONGLY_CONNECTED_COMPONENTS_GRAPH_GENERATORS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "edge.h"
+#include "compressed_sparse_row_graph.h"
+#include "work_stealing_thread_pool.h"
+
+namespace Graph
+{
+    // xoshiro256** seeded through splitmix64. Every (seed, stream) pair
+    // yields an independent sequence, so parallel generators can give each
+    // block of edges its own stream and stay deterministic.
+    class RandomStream
+    {
+    public:
+        explicit RandomStream(uint64_t seed, uint64_t stream = 0)
+            : state_()
+        {
+            uint64_t mixer = seed ^ (stream * 0xD1B54A32D192ED03ull);
+            for (auto& word : state_)
+            {
+                word = SplitMix(mixer);
+            }
+        }
+
+        uint64_t Next()
+        {
+            uint64_t result = Rotate(state_[1] * 5, 7) * 9;
+            uint64_t shifted = state_[1] << 17;
+            state_[2] ^= state_[0];
+            state_[3] ^= state_[1];
+            state_[1] ^= state_[2];
+            state_[0] ^= state_[3];
+            state_[2] ^= shifted;
+            state_[3] = Rotate(state_[3], 45);
+            return result;
+        }
+
+        // Uniform in [0, bound) by Lemire's multiply-shift, without the
+        // rejection step; the bias is at most bound / 2^64
+        uint64_t NextBelow(uint64_t bound)
+        {
+            return static_cast<uint64_t>(
+                (static_cast<unsigned __int128>(Next()) * bound) >> 64);
+        }
+
+        // Uniform in [0, 1)
+        double NextDouble()
+        {
+            return static_cast<double>(Next() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+    private:
+        static uint64_t SplitMix(uint64_t& state)
+        {
+            uint64_t mixed = (state += 0x9E3779B97F4A7C15ull);
+            mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+            return mixed ^ (mixed >> 31);
+        }
+
+        static uint64_t Rotate(uint64_t value, int shift)
+        {
+            return (value << shift) | (value >> (64 - shift));
+        }
+
+    private:
+        uint64_t state_[4];
+    };
+
+    // Output of a generator: vertices are [0, vertexCount)
+    template <typename VertexDescriptor>
+    struct GeneratedGraph
+    {
+        using TVertexDescriptor = VertexDescriptor;
+        using TEdge = Edge<TVertexDescriptor>;
+
+        size_t vertexCount;
+        std::vector<TEdge> edges;
+
+        CompressedSparseRowGraph<TVertexDescriptor, TEdge> ToCompressedSparseRowGraph() const
+        {
+            return CompressedSparseRowGraph<TVertexDescriptor, TEdge>(
+                vertexCount, edges.begin(), edges.end());
+        }
+    };
+
+    // Synthetic graph families for tests and benchmarks. Edges are produced
+    // in fixed-size blocks, each drawing from its own RandomStream, and the
+    // blocks are spread over a work-stealing pool. The output depends on the
+    // seed only, never on the thread count. Parallel edges and self-loops
+    // are kept unless a family says otherwise.
+    template <typename VertexDescriptor>
+    class GraphGenerator
+    {
+        static_assert(std::is_integral<VertexDescriptor>::value,
+            "GraphGenerator requires integral vertex descriptors");
+
+    public:
+        using TVertexDescriptor = VertexDescriptor;
+        using TEdge = Edge<TVertexDescriptor>;
+        using TGeneratedGraph = GeneratedGraph<TVertexDescriptor>;
+
+        // threadCount == 0 uses every hardware thread
+        explicit GraphGenerator(uint64_t seed, size_t threadCount = 0)
+            : seed_(seed)
+            , threadCount_(threadCount)
+        {}
+
+        // G(n, m): m edges with uniformly random endpoints
+        TGeneratedGraph ErdosRenyi(size_t vertexCount, size_t edgeCount) const
+        {
+            CheckVertexCount(vertexCount);
+            TGeneratedGraph graph{ vertexCount, {} };
+            Fill(graph.edges, edgeCount, kErdosRenyiSalt,
+                [vertexCount](RandomStream& random, size_t)
+            {
+                return TEdge(TVertexDescriptor(random.NextBelow(vertexCount)),
+                    TVertexDescriptor(random.NextBelow(vertexCount)));
+            });
+            return graph;
+        }
+
+        // Recursive-matrix (Kronecker) graph on 2^scale vertices. The
+        // defaults are the Graph500 parameters; d = 1 - a - b - c.
+        TGeneratedGraph Rmat(size_t scale, size_t edgeCount,
+            double a = 0.57, double b = 0.19, double c = 0.19) const
+        {
+            if (scale >= 63)
+            {
+                throw std::invalid_argument("R-MAT scale is too large");
+            }
+            size_t vertexCount = size_t(1) << scale;
+            CheckVertexCount(vertexCount);
+            TGeneratedGraph graph{ vertexCount, {} };
+            // Each quadrant choice uses 16 random bits, four levels per draw
+            const double unit = 65536.0;
+            uint64_t aLimit = static_cast<uint64_t>(a * unit);
+            uint64_t abLimit = static_cast<uint64_t>((a + b) * unit);
+            uint64_t abcLimit = static_cast<uint64_t>((a + b + c) * unit);
+            Fill(graph.edges, edgeCount, kRmatSalt,
+                [scale, aLimit, abLimit, abcLimit](RandomStream& random, size_t)
+            {
+                uint64_t source = 0;
+                uint64_t target = 0;
+                uint64_t bits = 0;
+                for (size_t bit = 0; bit < scale; ++bit)
+                {
+                    if (bit % 4 == 0)
+                    {
+                        bits = random.Next();
+                    }
+                    uint64_t draw = bits & 0xFFFF;
+                    bits >>= 16;
+                    // Quadrants in order a, b, c, d; kept branch-free
+                    uint64_t pastA = draw >= aLimit;
+                    uint64_t pastB = draw >= abLimit;
+                    uint64_t pastC = draw >= abcLimit;
+                    source = 2 * source + pastB;
+                    target = 2 * target + (pastA ^ pastB ^ pastC);
+                }
+                return TEdge(TVertexDescriptor(source), TVertexDescriptor(target));
+            });
+            return graph;
+        }
+
+        // Chung-Lu graph whose expected degrees follow a power law with the
+        // given exponent: vertex i has weight (i + 1)^(-1 / (exponent - 1))
+        // and both endpoints of every edge are drawn proportionally to weight.
+        TGeneratedGraph PowerLaw(size_t vertexCount, size_t edgeCount,
+            double exponent = 2.1) const
+        {
+            CheckVertexCount(vertexCount);
+            if (exponent <= 1.0)
+            {
+                throw std::invalid_argument("power-law exponent must exceed 1");
+            }
+            std::vector<double> cumulative(vertexCount);
+            double total = 0;
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                total += std::pow(double(vertex + 1), -1.0 / (exponent - 1.0));
+                cumulative[vertex] = total;
+            }
+            TGeneratedGraph graph{ vertexCount, {} };
+            const auto* weights = &cumulative;
+            Fill(graph.edges, edgeCount, kPowerLawSalt,
+                [weights, total](RandomStream& random, size_t)
+            {
+                auto pick = [weights, total, &random]()
+                {
+                    double draw = random.NextDouble() * total;
+                    auto position = std::upper_bound(weights->begin(), weights->end(), draw);
+                    if (position == weights->end())
+                    {
+                        --position;
+                    }
+                    return TVertexDescriptor(position - weights->begin());
+                };
+                TVertexDescriptor source = pick();
+                return TEdge(source, pick());
+            });
+            return graph;
+        }
+
+        // componentCount strongly connected components of componentSize
+        // consecutive vertices each: component c holds
+        // [c * componentSize, (c + 1) * componentSize). Every component gets
+        // a Hamiltonian cycle plus internalEdgeCount random internal edges;
+        // crossEdgeCount random edges only go from a lower to a higher
+        // component, so no other cycles exist.
+        TGeneratedGraph PlantedComponents(size_t componentCount, size_t componentSize,
+            size_t internalEdgeCount, size_t crossEdgeCount) const
+        {
+            size_t vertexCount = componentCount * componentSize;
+            CheckVertexCount(vertexCount);
+            TGeneratedGraph graph{ vertexCount, {} };
+            if (vertexCount == 0)
+            {
+                return graph;
+            }
+            size_t cycleEdgeCount = componentSize > 1 ? vertexCount : 0;
+            size_t randomInternalCount = componentSize > 1 ? internalEdgeCount : 0;
+            size_t randomCrossCount = componentCount > 1 ? crossEdgeCount : 0;
+            Fill(graph.edges, cycleEdgeCount + randomInternalCount + randomCrossCount,
+                kPlantedSalt,
+                [=](RandomStream& random, size_t index)
+            {
+                if (index < cycleEdgeCount)
+                {
+                    size_t first = index / componentSize * componentSize;
+                    size_t next = first + (index - first + 1) % componentSize;
+                    return TEdge(TVertexDescriptor(index), TVertexDescriptor(next));
+                }
+                if (index < cycleEdgeCount + randomInternalCount)
+                {
+                    size_t first = random.NextBelow(componentCount) * componentSize;
+                    return TEdge(TVertexDescriptor(first + random.NextBelow(componentSize)),
+                        TVertexDescriptor(first + random.NextBelow(componentSize)));
+                }
+                size_t from = random.NextBelow(componentCount);
+                size_t to = random.NextBelow(componentCount - 1);
+                if (to >= from)
+                {
+                    ++to;
+                }
+                else
+                {
+                    std::swap(from, to);
+                }
+                return TEdge(
+                    TVertexDescriptor(from * componentSize + random.NextBelow(componentSize)),
+                    TVertexDescriptor(to * componentSize + random.NextBelow(componentSize)));
+            });
+            return graph;
+        }
+
+        // layerCount layers of layerWidth vertices; every edge goes from a
+        // random vertex of some layer to a random vertex of the next one.
+        // Layer l holds [l * layerWidth, (l + 1) * layerWidth).
+        TGeneratedGraph LayeredDag(size_t layerCount, size_t layerWidth,
+            size_t edgeCount) const
+        {
+            size_t vertexCount = layerCount * layerWidth;
+            CheckVertexCount(vertexCount);
+            TGeneratedGraph graph{ vertexCount, {} };
+            if (layerCount < 2 || layerWidth == 0)
+            {
+                return graph;
+            }
+            Fill(graph.edges, edgeCount, kLayeredDagSalt,
+                [layerCount, layerWidth](RandomStream& random, size_t)
+            {
+                size_t layer = random.NextBelow(layerCount - 1);
+                size_t source = layer * layerWidth + random.NextBelow(layerWidth);
+                size_t target = (layer + 1) * layerWidth + random.NextBelow(layerWidth);
+                return TEdge(TVertexDescriptor(source), TVertexDescriptor(target));
+            });
+            return graph;
+        }
+
+    private:
+        static constexpr size_t kBlockSize = size_t(1) << 16;
+        static constexpr uint64_t kErdosRenyiSalt = 1;
+        static constexpr uint64_t kRmatSalt = 2;
+        static constexpr uint64_t kPowerLawSalt = 3;
+        static constexpr uint64_t kPlantedSalt = 4;
+        static constexpr uint64_t kLayeredDagSalt = 5;
+
+        static void CheckVertexCount(size_t vertexCount)
+        {
+            if (vertexCount > 0 && vertexCount - 1 >
+                static_cast<uint64_t>(std::numeric_limits<TVertexDescriptor>::max()))
+            {
+                throw std::invalid_argument("too many vertices for the descriptor type");
+            }
+        }
+
+        // edges[i] = make(stream of i's block, i) for i in [0, edgeCount)
+        template <typename TMake>
+        void Fill(std::vector<TEdge>& edges, size_t edgeCount, uint64_t salt,
+            TMake make) const
+        {
+            edges.assign(edgeCount, TEdge(TVertexDescriptor(0), TVertexDescriptor(0)));
+            size_t blockCount = (edgeCount + kBlockSize - 1) / kBlockSize;
+            uint64_t seed = seed_ ^ (salt << 56);
+            auto fillBlocks = [&edges, &make, edgeCount, seed](size_t begin, size_t end)
+            {
+                for (size_t block = begin; block < end; ++block)
+                {
+                    RandomStream random(seed, block);
+                    size_t last = std::min(edgeCount, (block + 1) * kBlockSize);
+                    for (size_t index = block * kBlockSize; index < last; ++index)
+                    {
+                        edges[index] = make(random, index);
+                    }
+                }
+            };
+            if (blockCount <= 1 || threadCount_ == 1)
+            {
+                fillBlocks(0, blockCount);
+                return;
+            }
+            WorkStealingThreadPool pool(threadCount_);
+            ParallelFor(pool, 0, blockCount, 1, fillBlocks);
+        }
+
+    private:
+        uint64_t seed_;
+        size_t threadCount_;
+    };
+}
+
+#endif
\ No newline at end of file
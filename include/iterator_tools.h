@@ -1,7 +1,10 @@
 #ifndef STRONGLY_CONNECTED_COMPONENTS_ITERATOR_TOOLS_H_
 #define STRONGLY_CONNECTED_COMPONENTS_ITERATOR_TOOLS_H_
 
+#include <cstddef>
 #include <iterator>
+#include <memory>
+#include <type_traits>
 
 template <typename Iterator>
 class IteratorRange
@@ -56,7 +59,7 @@ public:
         const typename KeyValueIterator::value_type::first_type&,
         const typename KeyValueIterator::value_type::second_type&>::type;
     using difference_type = typename KeyValueIterator::difference_type;
-    using pointer = const typename KeyValueIterator::pointer;
+    using pointer = typename std::add_pointer<reference>::type;
 
     KeyValueIteratorAdaptor()
         : iter_()
@@ -102,12 +105,12 @@ public:
         return aCopy;
     }
 
-    bool operator == (const KeyValueIteratorAdaptor<KeyValueIterator, UseKey>& other)
+    bool operator == (const KeyValueIteratorAdaptor<KeyValueIterator, UseKey>& other) const
     {
         return iter_ == other.iter_;
     }
 
-    bool operator != (const KeyValueIteratorAdaptor<KeyValueIterator, UseKey>& other)
+    bool operator != (const KeyValueIteratorAdaptor<KeyValueIterator, UseKey>& other) const
     {
         return iter_ != other.iter_;
     }
@@ -139,4 +142,177 @@ using KeyIterator = KeyValueIteratorAdaptor<KeyValueIterator, true>;
 template <typename KeyValueIterator>
 using ValueIterator = KeyValueIteratorAdaptor<KeyValueIterator, false>;
 
+template <typename Value>
+class ArrowProxy
+{
+public:
+    explicit ArrowProxy(const Value& value)
+        : value_(value)
+    {}
+
+    const Value* operator -> () const
+    {
+        return std::addressof(value_);
+    }
+
+private:
+    Value value_;
+};
+
+template <typename Value>
+class CountingIterator
+{
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Value;
+    using reference = const Value&;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Value*;
+
+    CountingIterator()
+        : index_(0)
+        , value_()
+    {}
+
+    // Counts in size_t and converts on the way out, so a range over
+    // [0, count) may end one past the largest Value
+    explicit CountingIterator(size_t index)
+        : index_(index)
+        , value_(static_cast<Value>(index))
+    {}
+
+    reference operator * () const
+    {
+        return value_;
+    }
+
+    pointer operator -> () const
+    {
+        return std::addressof(value_);
+    }
+
+    CountingIterator<Value>& operator ++()
+    {
+        value_ = static_cast<Value>(++index_);
+        return *this;
+    }
+
+    CountingIterator<Value>& operator --()
+    {
+        value_ = static_cast<Value>(--index_);
+        return *this;
+    }
+
+    CountingIterator<Value> operator ++(int dummy)
+    {
+        auto aCopy = *this;
+        ++*this;
+        return aCopy;
+    }
+
+    CountingIterator<Value> operator --(int dummy)
+    {
+        auto aCopy = *this;
+        --*this;
+        return aCopy;
+    }
+
+    bool operator == (const CountingIterator<Value>& other) const
+    {
+        return index_ == other.index_;
+    }
+
+    bool operator != (const CountingIterator<Value>& other) const
+    {
+        return index_ != other.index_;
+    }
+
+private:
+    size_t index_;
+    Value value_;
+};
+
+template <typename Iterator, typename Predicate>
+class FilterIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    using reference = typename std::iterator_traits<Iterator>::reference;
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    using pointer = Iterator;
+
+    FilterIterator()
+        : iter_()
+        , end_()
+        , pred_()
+    {}
+
+    FilterIterator(Iterator iter, Iterator end, Predicate pred)
+        : iter_(iter)
+        , end_(end)
+        , pred_(pred)
+    {
+        SkipRejected();
+    }
+
+    reference operator * () const
+    {
+        return *iter_;
+    }
+
+    // Chains to the underlying iterator's own operator ->
+    pointer operator -> () const
+    {
+        return iter_;
+    }
+
+    FilterIterator<Iterator, Predicate>& operator ++()
+    {
+        ++iter_;
+        SkipRejected();
+        return *this;
+    }
+
+    FilterIterator<Iterator, Predicate> operator ++(int dummy)
+    {
+        auto aCopy = *this;
+        ++*this;
+        return aCopy;
+    }
+
+    bool operator == (const FilterIterator<Iterator, Predicate>& other) const
+    {
+        return iter_ == other.iter_;
+    }
+
+    bool operator != (const FilterIterator<Iterator, Predicate>& other) const
+    {
+        return iter_ != other.iter_;
+    }
+
+private:
+    void SkipRejected()
+    {
+        while (iter_ != end_ && !pred_(*iter_))
+        {
+            ++iter_;
+        }
+    }
+
+private:
+    Iterator iter_;
+    Iterator end_;
+    Predicate pred_;
+};
+
+template <typename Iterator, typename Predicate>
+IteratorRange<FilterIterator<Iterator, Predicate>> MakeFilteredRange(
+    const IteratorRange<Iterator>& range, Predicate pred)
+{
+    return IteratorRange<FilterIterator<Iterator, Predicate>>(
+        FilterIterator<Iterator, Predicate>(range.begin(), range.end(), pred),
+        FilterIterator<Iterator, Predicate>(range.end(), range.end(), pred));
+}
+
 #endif
\ No newline at end of file
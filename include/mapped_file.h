@@ -0,0 +1,128 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_MAPPED_FILE_H_
+#define STRONGLY_CONNECTED_COMPONENTS_MAPPED_FILE_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Graph
+{
+    // Read-only private mapping of a whole file. Pages are faulted in on
+    // first access, so opening costs the same for any file size.
+    class MappedFile
+    {
+    public:
+        MappedFile()
+            : data_(nullptr)
+            , size_(0)
+        {}
+
+        explicit MappedFile(const std::string& path)
+            : data_(nullptr)
+            , size_(0)
+        {
+            int descriptor = ::open(path.c_str(), O_RDONLY);
+            if (descriptor < 0)
+            {
+                throw std::runtime_error(ErrorMessage("cannot open", path));
+            }
+            struct stat status;
+            if (::fstat(descriptor, &status) != 0)
+            {
+                std::string message = ErrorMessage("cannot stat", path);
+                ::close(descriptor);
+                throw std::runtime_error(message);
+            }
+            size_ = static_cast<size_t>(status.st_size);
+            if (size_ > 0)
+            {
+                void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if (data == MAP_FAILED)
+                {
+                    std::string message = ErrorMessage("cannot map", path);
+                    ::close(descriptor);
+                    throw std::runtime_error(message);
+                }
+                data_ = static_cast<const char*>(data);
+            }
+            // The mapping stays valid after the descriptor is closed
+            ::close(descriptor);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other)
+            : data_(other.data_)
+            , size_(other.size_)
+        {
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+
+        MappedFile& operator=(MappedFile&& other)
+        {
+            if (this != &other)
+            {
+                Unmap();
+                std::swap(data_, other.data_);
+                std::swap(size_, other.size_);
+            }
+            return *this;
+        }
+
+        ~MappedFile()
+        {
+            Unmap();
+        }
+
+        const char* Data() const
+        {
+            return data_;
+        }
+
+        size_t Size() const
+        {
+            return size_;
+        }
+
+        // Hints that the whole file will be read front to back
+        void AdviseSequential() const
+        {
+            if (data_ != nullptr)
+            {
+                ::madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL);
+            }
+        }
+
+    private:
+        static std::string ErrorMessage(const char* what, const std::string& path)
+        {
+            return std::string(what) + " '" + path + "': " + std::strerror(errno);
+        }
+
+        void Unmap()
+        {
+            if (data_ != nullptr)
+            {
+                ::munmap(const_cast<char*>(data_), size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+
+    private:
+        const char* data_;
+        size_t size_;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,203 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_MAPPED_GRAPH_H_
+#define STRONGLY_CONNECTED_COMPONENTS_MAPPED_GRAPH_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "iterator_tools.h"
+#include "graph_containers.h"
+#include "out_edge_iterator.h"
+#include "property_map.h"
+#include "binary_graph_format.h"
+#include "mapped_file.h"
+#include "edge.h"
+
+namespace Graph
+{
+    // Read-only graph served straight from a memory-mapped file written by
+    // WriteBinaryGraph. Opening validates the header, the file size and the
+    // first and last offsets only; offsets and targets are read in place as
+    // the algorithms touch them. Files that may be corrupt must go through
+    // Validate() before any traversal. Offers the same interface as
+    // CompressedSparseRowGraph.
+    template <typename VertexDescriptor, typename Edge>
+    class MappedGraph
+    {
+        static_assert(std::is_integral<VertexDescriptor>::value,
+            "MappedGraph requires integral vertex descriptors");
+
+    public:
+        using TVertexDescriptor = VertexDescriptor;
+        using TEdge = Edge;
+
+        using ConstVertexIterator = CountingIterator<TVertexDescriptor>;
+        using ConstEdgeIterator = OutEdgeIterator<TEdge, const TVertexDescriptor*>;
+
+        explicit MappedGraph(const std::string& path)
+            : file_(path)
+            , vertexCount_(0)
+            , edgeCount_(0)
+            , offsets_(nullptr)
+            , targets_(nullptr)
+        {
+            if (file_.Size() < sizeof(BinaryGraphHeader))
+            {
+                throw std::runtime_error("'" + path + "' is too small for a binary graph");
+            }
+            const auto* header = reinterpret_cast<const BinaryGraphHeader*>(file_.Data());
+            ValidateBinaryGraphHeader(*header, file_.Size(), sizeof(TVertexDescriptor));
+            vertexCount_ = header->vertexCount;
+            edgeCount_ = header->edgeCount;
+            offsets_ = reinterpret_cast<const uint64_t*>(
+                file_.Data() + sizeof(BinaryGraphHeader));
+            targets_ = reinterpret_cast<const TVertexDescriptor*>(
+                offsets_ + vertexCount_ + 1);
+            if (offsets_[0] != 0 || offsets_[vertexCount_] != edgeCount_)
+            {
+                throw std::runtime_error("'" + path + "' has offsets that do not span its targets");
+            }
+        }
+
+        // Reads the whole file once; throws std::runtime_error unless every
+        // offset and target is in range
+        void Validate() const
+        {
+            ValidateBinaryGraphArrays(offsets_, targets_, vertexCount_, edgeCount_);
+        }
+
+        bool IsDirected() const
+        {
+            return true;
+        }
+
+        bool AllowParallelEdges() const
+        {
+            return true;
+        }
+
+        size_t VertexCount() const
+        {
+            return vertexCount_;
+        }
+
+        bool IsVerticesEmpty() const
+        {
+            return VertexCount() == 0;
+        }
+
+        IteratorRange<ConstVertexIterator> Vertices() const
+        {
+            return IteratorRange<ConstVertexIterator>(
+                ConstVertexIterator(0), ConstVertexIterator(VertexCount()));
+        }
+
+        bool ContainsVertex(const TVertexDescriptor& vertex) const
+        {
+            return !(vertex < TVertexDescriptor(0)) &&
+                static_cast<size_t>(vertex) < VertexCount();
+        }
+
+        bool IsOutEdgesEmpty(const TVertexDescriptor& vertex) const
+        {
+            return OutDegree(vertex) == 0;
+        }
+
+        size_t OutDegree(const TVertexDescriptor& vertex) const
+        {
+            auto index = static_cast<size_t>(vertex);
+            return offsets_[index + 1] - offsets_[index];
+        }
+
+        IteratorRange<ConstEdgeIterator> OutEdges(const TVertexDescriptor& vertex) const
+        {
+            auto index = static_cast<size_t>(vertex);
+            return IteratorRange<ConstEdgeIterator>(
+                ConstEdgeIterator(vertex, targets_ + offsets_[index]),
+                ConstEdgeIterator(vertex, targets_ + offsets_[index + 1]));
+        }
+
+        bool TryGetEdges(const TVertexDescriptor& vertex,
+            IteratorRange<ConstEdgeIterator>& range) const
+        {
+            if (ContainsVertex(vertex))
+            {
+                range = OutEdges(vertex);
+                return true;
+            }
+            return false;
+        }
+
+        size_t EdgeCount() const
+        {
+            return edgeCount_;
+        }
+
+        List<TEdge> GetEdges() const
+        {
+            List<TEdge> edges;
+            for (const auto& vertex : Vertices())
+            {
+                for (const auto& edge : OutEdges(vertex))
+                {
+                    edges.push_back(edge);
+                }
+            }
+            return edges;
+        }
+
+        bool ContainsEdge(const TVertexDescriptor& source,
+            const TVertexDescriptor& target) const
+        {
+            if (!ContainsVertex(source))
+            {
+                return false;
+            }
+            auto index = static_cast<size_t>(source);
+            auto first = targets_ + offsets_[index];
+            auto last = targets_ + offsets_[index + 1];
+            return std::find(first, last, target) != last;
+        }
+
+        bool ContainsEdge(const TEdge& edge) const
+        {
+            return ContainsEdge(edge.Source(), edge.Target());
+        }
+
+        // vertexCount + 1 entries, as in CompressedSparseRowGraph::Offsets
+        const uint64_t* Offsets() const
+        {
+            return offsets_;
+        }
+
+        const TVertexDescriptor* Targets() const
+        {
+            return targets_;
+        }
+
+    private:
+        MappedFile file_;
+        size_t vertexCount_;
+        size_t edgeCount_;
+        const uint64_t* offsets_;
+        const TVertexDescriptor* targets_;
+    };
+
+    template <typename VertexDescriptor, typename Edge>
+    struct DefaultPropertyMapSelector<MappedGraph<VertexDescriptor, Edge>>
+    {
+        using type = VectorPropertyMapSelector;
+    };
+
+    // Static graphs are traversal-only, so searches use vector stacks
+    template <typename VertexDescriptor, typename Edge>
+    struct DefaultContainerPolicy<MappedGraph<VertexDescriptor, Edge>>
+    {
+        using type = FlatContainerPolicy;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,243 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_NODE_POOL_H_
+#define STRONGLY_CONNECTED_COMPONENTS_NODE_POOL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace Graph
+{
+    // Arena for the small fixed-size nodes of lists, maps and sets. Memory
+    // is carved from large blocks; freed nodes go to a free list of their
+    // size class and are handed out again, and the blocks are returned to
+    // the system all at once by Release or the destructor. Requests larger
+    // than kMaxNodeSize (bucket arrays, mostly) bypass the pool.
+    //
+    // Not thread-safe: containers drawing from one pool must be modified by
+    // one thread at a time.
+    class NodePool
+    {
+    public:
+        static constexpr size_t kAlignment = alignof(std::max_align_t);
+        static constexpr size_t kMaxNodeSize = 256;
+        static constexpr size_t kInitialBlockSize = 64 * 1024;
+        static constexpr size_t kMaxBlockSize = 4 * 1024 * 1024;
+
+        // Containers default-constructed on this thread while a scope is
+        // open draw from its pool; outside any scope they use the heap
+        class Scope
+        {
+        public:
+            explicit Scope(NodePool& pool)
+                : previous_(CurrentSlot())
+            {
+                CurrentSlot() = &pool;
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            ~Scope()
+            {
+                CurrentSlot() = previous_;
+            }
+
+        private:
+            NodePool* previous_;
+        };
+
+        NodePool()
+            : blocks_(nullptr)
+            , cursor_(nullptr)
+            , end_(nullptr)
+            , nextBlockSize_(kInitialBlockSize)
+            , reservedBytes_(0)
+            , freeLists_()
+        {}
+
+        // Allocators hold a pointer to the pool, so it never moves
+        NodePool(const NodePool&) = delete;
+        NodePool& operator=(const NodePool&) = delete;
+
+        ~NodePool()
+        {
+            Release();
+        }
+
+        static NodePool* Current()
+        {
+            return CurrentSlot();
+        }
+
+        // Bytes taken from the system, including the free lists
+        size_t ReservedBytes() const
+        {
+            return reservedBytes_;
+        }
+
+        void* Allocate(size_t bytes)
+        {
+            if (bytes > kMaxNodeSize)
+            {
+                return ::operator new(bytes);
+            }
+            size_t sizeClass = SizeClass(bytes);
+            FreeNode* node = freeLists_[sizeClass];
+            if (node != nullptr)
+            {
+                freeLists_[sizeClass] = node->next;
+                return node;
+            }
+            size_t size = sizeClass * kAlignment;
+            if (static_cast<size_t>(end_ - cursor_) < size)
+            {
+                AddBlock();
+            }
+            void* result = cursor_;
+            cursor_ += size;
+            return result;
+        }
+
+        void Deallocate(void* pointer, size_t bytes)
+        {
+            if (bytes > kMaxNodeSize)
+            {
+                ::operator delete(pointer);
+                return;
+            }
+            size_t sizeClass = SizeClass(bytes);
+            freeLists_[sizeClass] = new (pointer) FreeNode{ freeLists_[sizeClass] };
+        }
+
+        // Frees every block in one sweep. Whatever still points into the
+        // pool is left dangling, so containers using it must be gone or
+        // never touched again.
+        void Release()
+        {
+            while (blocks_ != nullptr)
+            {
+                Block* next = blocks_->next;
+                ::operator delete(blocks_);
+                blocks_ = next;
+            }
+            cursor_ = end_ = nullptr;
+            nextBlockSize_ = kInitialBlockSize;
+            reservedBytes_ = 0;
+            std::fill(freeLists_, freeLists_ + kSizeClassCount, nullptr);
+        }
+
+    private:
+        struct FreeNode
+        {
+            FreeNode* next;
+        };
+
+        struct alignas(std::max_align_t) Block
+        {
+            Block* next;
+        };
+
+        static constexpr size_t kSizeClassCount = kMaxNodeSize / kAlignment + 1;
+
+        static NodePool*& CurrentSlot()
+        {
+            static thread_local NodePool* current = nullptr;
+            return current;
+        }
+
+        static size_t SizeClass(size_t bytes)
+        {
+            return std::max<size_t>(1, (bytes + kAlignment - 1) / kAlignment);
+        }
+
+        // The tail of the old block is abandoned; it is smaller than a node
+        void AddBlock()
+        {
+            size_t size = nextBlockSize_;
+            nextBlockSize_ = std::min(kMaxBlockSize, nextBlockSize_ * 2);
+            auto* block = static_cast<Block*>(::operator new(size));
+            block->next = blocks_;
+            blocks_ = block;
+            cursor_ = reinterpret_cast<char*>(block + 1);
+            end_ = reinterpret_cast<char*>(block) + size;
+            reservedBytes_ += size;
+        }
+
+    private:
+        Block* blocks_;
+        char* cursor_;
+        char* end_;
+        size_t nextBlockSize_;
+        size_t reservedBytes_;
+        FreeNode* freeLists_[kSizeClassCount];
+    };
+
+    // Standard allocator over a NodePool. A default-constructed one takes
+    // the pool of the innermost open NodePool::Scope, or none, in which case
+    // it behaves like std::allocator. Rebound copies share the pool, so the
+    // nodes of nested containers land in it as well.
+    template <typename T>
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        PoolAllocator() noexcept
+            : pool_(NodePool::Current())
+        {}
+
+        explicit PoolAllocator(NodePool* pool) noexcept
+            : pool_(pool)
+        {}
+
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U>& other) noexcept
+            : pool_(other.GetPool())
+        {}
+
+        NodePool* GetPool() const
+        {
+            return pool_;
+        }
+
+        T* allocate(size_t count)
+        {
+            if (pool_ == nullptr || alignof(T) > NodePool::kAlignment)
+            {
+                return static_cast<T*>(::operator new(count * sizeof(T)));
+            }
+            return static_cast<T*>(pool_->Allocate(count * sizeof(T)));
+        }
+
+        void deallocate(T* pointer, size_t count)
+        {
+            if (pool_ == nullptr || alignof(T) > NodePool::kAlignment)
+            {
+                ::operator delete(pointer);
+                return;
+            }
+            pool_->Deallocate(pointer, count * sizeof(T));
+        }
+
+    private:
+        NodePool* pool_;
+    };
+
+    template <typename T, typename U>
+    bool operator==(const PoolAllocator<T>& left, const PoolAllocator<U>& right)
+    {
+        return left.GetPool() == right.GetPool();
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const PoolAllocator<T>& left, const PoolAllocator<U>& right)
+    {
+        return left.GetPool() != right.GetPool();
+    }
+}
+
+#endif
\ No newline at end of file
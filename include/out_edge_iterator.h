@@ -0,0 +1,76 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_OUT_EDGE_ITERATOR_H_
+#define STRONGLY_CONNECTED_COMPONENTS_OUT_EDGE_ITERATOR_H_
+
+#include <cstddef>
+#include <iterator>
+
+#include "iterator_tools.h"
+
+namespace Graph
+{
+    // Synthesizes edges of a single vertex from an iterator over its targets.
+    // Used by graphs that store bare target arrays instead of edge objects,
+    // so the edges are returned by value.
+    template <typename Edge, typename TargetIterator>
+    class OutEdgeIterator
+    {
+    public:
+        using TEdge = Edge;
+        using TVertexDescriptor = typename TEdge::TVertexDescriptor;
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TEdge;
+        using reference = TEdge;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ArrowProxy<TEdge>;
+
+        OutEdgeIterator()
+            : source_()
+            , target_()
+        {}
+
+        OutEdgeIterator(const TVertexDescriptor& source, TargetIterator target)
+            : source_(source)
+            , target_(target)
+        {}
+
+        reference operator * () const
+        {
+            return TEdge(source_, *target_);
+        }
+
+        pointer operator -> () const
+        {
+            return pointer(**this);
+        }
+
+        OutEdgeIterator<Edge, TargetIterator>& operator ++()
+        {
+            ++target_;
+            return *this;
+        }
+
+        OutEdgeIterator<Edge, TargetIterator> operator ++(int dummy)
+        {
+            auto aCopy = *this;
+            ++*this;
+            return aCopy;
+        }
+
+        bool operator == (const OutEdgeIterator<Edge, TargetIterator>& other) const
+        {
+            return target_ == other.target_;
+        }
+
+        bool operator != (const OutEdgeIterator<Edge, TargetIterator>& other) const
+        {
+            return target_ != other.target_;
+        }
+
+    private:
+        TVertexDescriptor source_;
+        TargetIterator target_;
+    };
+}
+
+#endif
\ No newline at end of file
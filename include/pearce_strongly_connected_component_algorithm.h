@@ -0,0 +1,179 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_PEARCE_STRONGLY_CONNECTED_COMPONENT_ALGORITHM_H_
+#define STRONGLY_CONNECTED_COMPONENTS_PEARCE_STRONGLY_CONNECTED_COMPONENT_ALGORITHM_H_
+
+#include "iterator_tools.h"
+#include "graph_containers.h"
+#include "property_map.h"
+#include "algorithm_base.h"
+
+namespace Graph
+{
+    // Pearce's space-efficient variant of Tarjan's algorithm. Every vertex
+    // owns a single rindex word that serves as visited flag, lowlink and,
+    // once the vertex is finished, its component slot. Lowlinks are updated
+    // while an edge is examined, so each edge is traversed once.
+    //
+    // Components are numbered in the order they are completed (reverse
+    // topological order), exactly as StronglyConnectedComponentAlgorithm
+    // numbers them.
+    //
+    // With CollectStatistics only discoveries, examined and tree edges are
+    // counted; telling back edges from cross edges would need a second word.
+    template <typename TGraph, typename TPropertyMapSelector =
+        typename DefaultPropertyMapSelector<TGraph>::type,
+        typename TStatistics = NoStatistics, typename TContainerPolicy =
+            typename DefaultContainerPolicy<TGraph>::type>
+    class PearceStronglyConnectedComponentAlgorithm :
+        public AlgorithmBase<TGraph, TStatistics>
+    {
+    public:
+        using BaseType = AlgorithmBase<TGraph, TStatistics>;
+        using TVertexDescriptor = typename TGraph::TVertexDescriptor;
+        using TEdge = typename TGraph::TEdge;
+        using TComponentMap = typename TPropertyMapSelector::template Map<
+            TVertexDescriptor, size_t>;
+
+        explicit PearceStronglyConnectedComponentAlgorithm(const TGraph& graph)
+            : BaseType(graph)
+            , rindex_()
+            , stack_()
+            , componentsCount_(0)
+            , index_(0)
+            , componentSlot_(0)
+        {}
+
+        const TComponentMap& GetComponents() const
+        {
+            return rindex_;
+        }
+
+        size_t GetComponentsCount() const
+        {
+            return componentsCount_;
+        }
+
+    protected:
+        void Initialize() override
+        {
+            const auto& graph = BaseType::GetGraph();
+            rindex_.Reset(graph);
+            for (const auto& vertex : graph.Vertices())
+            {
+                rindex_[vertex] = 0;
+            }
+            componentsCount_ = 0;
+            index_ = 1;
+            componentSlot_ = graph.VertexCount() - 1;
+            BaseType::Statistics().ResultBytes(rindex_.ByteSize());
+        }
+
+        void InternalCompute() override
+        {
+            const auto& graph = BaseType::GetGraph();
+            for (const auto& vertex : graph.Vertices())
+            {
+                if (rindex_[vertex] == 0)
+                {
+                    Visit(vertex);
+                }
+            }
+
+            // Component slots are handed out downwards from VertexCount() - 1
+            const size_t lastSlot = graph.VertexCount() - 1;
+            for (const auto& vertex : graph.Vertices())
+            {
+                rindex_[vertex] = lastSlot - rindex_[vertex];
+            }
+        }
+
+    private:
+        struct SearchFrame
+        {
+        public:
+            SearchFrame(const TVertexDescriptor& vertex,
+                IteratorRange<typename TGraph::ConstEdgeIterator> edges)
+                : vertex(vertex)
+                , edgesBegin(edges.begin())
+                , edgesEnd(edges.end())
+                , isRoot(true)
+            {}
+
+            TVertexDescriptor vertex;
+            typename TGraph::ConstEdgeIterator edgesBegin;
+            typename TGraph::ConstEdgeIterator edgesEnd;
+            bool isRoot;
+        };
+
+        void Visit(const TVertexDescriptor& root)
+        {
+            const auto& graph = BaseType::GetGraph();
+            auto& rindex = rindex_;
+            auto& statistics = BaseType::Statistics();
+            typename TContainerPolicy::template Stack<SearchFrame> todo;
+            rindex[root] = index_++;
+            statistics.DiscoverVertex();
+            todo.push(SearchFrame(root, graph.OutEdges(root)));
+            statistics.StackDepth(todo.size());
+            while (!todo.empty())
+            {
+                auto& frame = todo.top();
+                if (frame.edgesBegin == frame.edgesEnd)
+                {
+                    Finish(frame.vertex, frame.isRoot);
+                    todo.pop();
+                    continue;
+                }
+
+                auto target = frame.edgesBegin->Target();
+                if (rindex[target] == 0)
+                {
+                    // The edge is examined again once target is finished,
+                    // which is when its lowlink is folded into this frame
+                    rindex[target] = index_++;
+                    statistics.DiscoverVertex();
+                    statistics.TreeEdge();
+                    todo.push(SearchFrame(target, graph.OutEdges(target)));
+                    statistics.StackDepth(todo.size());
+                    continue;
+                }
+                if (rindex[target] < rindex[frame.vertex])
+                {
+                    rindex[frame.vertex] = rindex[target];
+                    frame.isRoot = false;
+                }
+                statistics.ExamineEdge();
+                ++frame.edgesBegin;
+            }
+        }
+
+        void Finish(const TVertexDescriptor& vertex, bool isRoot)
+        {
+            auto& rindex = rindex_;
+            if (!isRoot)
+            {
+                stack_.push(vertex);
+                return;
+            }
+
+            --index_;
+            while (!stack_.empty() && rindex[vertex] <= rindex[stack_.top()])
+            {
+                rindex[stack_.top()] = componentSlot_;
+                stack_.pop();
+                --index_;
+            }
+            rindex[vertex] = componentSlot_;
+            --componentSlot_;
+            ++componentsCount_;
+        }
+
+    private:
+        TComponentMap rindex_;
+        typename TContainerPolicy::template Stack<TVertexDescriptor> stack_;
+        size_t componentsCount_;
+        size_t index_;
+        size_t componentSlot_;
+    };
+}
+
+#endif
\ No newline at end of file
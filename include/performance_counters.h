@@ -0,0 +1,234 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_PERFORMANCE_COUNTERS_H_
+#define STRONGLY_CONNECTED_COMPONENTS_PERFORMANCE_COUNTERS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Graph
+{
+    enum PerformanceEvent
+    {
+        CYCLES, INSTRUCTIONS, LLC_MISSES, DTLB_MISSES, BRANCH_MISSES,
+        PERFORMANCE_EVENT_COUNT
+    };
+
+    inline const char* PerformanceEventName(PerformanceEvent event)
+    {
+        static const char* const kNames[PERFORMANCE_EVENT_COUNT] = {
+            "cycles", "instructions", "llc_misses", "dtlb_misses", "branch_misses" };
+        return kNames[event];
+    }
+
+    // Totals of the events counted so far; an event the kernel or the
+    // hardware refused is marked unavailable and stays zero.
+    struct PerformanceCounts
+    {
+        uint64_t values[PERFORMANCE_EVENT_COUNT];
+        bool available[PERFORMANCE_EVENT_COUNT];
+    };
+
+    // User-space hardware counters of the calling thread and of every thread
+    // it starts while they are open, read through perf_event_open. Each
+    // event is opened on its own, so a missing one does not disable the
+    // rest, and nothing throws: without permission, without a PMU or off
+    // Linux every event is simply unavailable.
+    //
+    // Counts are scaled up when the kernel multiplexed the counters.
+    class PerformanceCounters
+    {
+    public:
+        PerformanceCounters()
+            : descriptors_()
+            , counts_()
+        {
+            for (int event = 0; event < PERFORMANCE_EVENT_COUNT; ++event)
+            {
+                descriptors_[event] = Open(static_cast<PerformanceEvent>(event));
+                counts_.available[event] = descriptors_[event] >= 0;
+            }
+        }
+
+        PerformanceCounters(const PerformanceCounters&) = delete;
+        PerformanceCounters& operator=(const PerformanceCounters&) = delete;
+
+        PerformanceCounters(PerformanceCounters&& other)
+            : descriptors_()
+            , counts_(other.counts_)
+        {
+            for (int event = 0; event < PERFORMANCE_EVENT_COUNT; ++event)
+            {
+                descriptors_[event] = other.descriptors_[event];
+                other.descriptors_[event] = -1;
+                other.counts_.available[event] = false;
+            }
+        }
+
+        PerformanceCounters& operator=(PerformanceCounters&& other)
+        {
+            if (this != &other)
+            {
+                for (int event = 0; event < PERFORMANCE_EVENT_COUNT; ++event)
+                {
+                    std::swap(descriptors_[event], other.descriptors_[event]);
+                }
+                std::swap(counts_, other.counts_);
+            }
+            return *this;
+        }
+
+        ~PerformanceCounters()
+        {
+            for (int event = 0; event < PERFORMANCE_EVENT_COUNT; ++event)
+            {
+                Close(descriptors_[event]);
+            }
+        }
+
+        bool IsAvailable(PerformanceEvent event) const
+        {
+            return counts_.available[event];
+        }
+
+        bool IsAnyAvailable() const
+        {
+            for (int event = 0; event < PERFORMANCE_EVENT_COUNT; ++event)
+            {
+                if (counts_.available[event])
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const PerformanceCounts& Get() const
+        {
+            return counts_;
+        }
+
+        void Reset()
+        {
+            std::memset(counts_.values, 0, sizeof(counts_.values));
+        }
+
+        // Start/Stop pairs accumulate into Get() until Reset
+        void Start()
+        {
+#ifdef __linux__
+            for (int event = 0; event < PERFORMANCE_EVENT_COUNT; ++event)
+            {
+                if (descriptors_[event] >= 0)
+                {
+                    ::ioctl(descriptors_[event], PERF_EVENT_IOC_RESET, 0);
+                    ::ioctl(descriptors_[event], PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        void Stop()
+        {
+#ifdef __linux__
+            for (int event = 0; event < PERFORMANCE_EVENT_COUNT; ++event)
+            {
+                if (descriptors_[event] >= 0)
+                {
+                    ::ioctl(descriptors_[event], PERF_EVENT_IOC_DISABLE, 0);
+                }
+            }
+            for (int event = 0; event < PERFORMANCE_EVENT_COUNT; ++event)
+            {
+                // value, time enabled, time running
+                uint64_t reading[3];
+                if (descriptors_[event] >= 0 &&
+                    ::read(descriptors_[event], reading, sizeof(reading)) ==
+                    static_cast<ssize_t>(sizeof(reading)) && reading[2] > 0)
+                {
+                    counts_.values[event] += reading[2] < reading[1] ?
+                        static_cast<uint64_t>(static_cast<double>(reading[0]) *
+                            reading[1] / reading[2]) :
+                        reading[0];
+                }
+            }
+#endif
+        }
+
+    private:
+#ifdef __linux__
+        static int Open(PerformanceEvent event)
+        {
+            struct perf_event_attr attributes;
+            std::memset(&attributes, 0, sizeof(attributes));
+            attributes.size = sizeof(attributes);
+            attributes.disabled = 1;
+            attributes.inherit = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                PERF_FORMAT_TOTAL_TIME_RUNNING;
+            switch (event)
+            {
+            case CYCLES:
+                attributes.type = PERF_TYPE_HARDWARE;
+                attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case INSTRUCTIONS:
+                attributes.type = PERF_TYPE_HARDWARE;
+                attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case LLC_MISSES:
+                attributes.type = PERF_TYPE_HW_CACHE;
+                attributes.config = CacheEvent(PERF_COUNT_HW_CACHE_LL);
+                break;
+            case DTLB_MISSES:
+                attributes.type = PERF_TYPE_HW_CACHE;
+                attributes.config = CacheEvent(PERF_COUNT_HW_CACHE_DTLB);
+                break;
+            default:
+                attributes.type = PERF_TYPE_HARDWARE;
+                attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            }
+            return static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+        }
+
+        // Read misses of the given cache
+        static uint64_t CacheEvent(uint64_t cache)
+        {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        }
+
+        static void Close(int descriptor)
+        {
+            if (descriptor >= 0)
+            {
+                ::close(descriptor);
+            }
+        }
+#else
+        static int Open(PerformanceEvent)
+        {
+            return -1;
+        }
+
+        static void Close(int)
+        {}
+#endif
+
+    private:
+        int descriptors_[PERFORMANCE_EVENT_COUNT];
+        PerformanceCounts counts_;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,233 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_PROPERTY_MAP_H_
+#define STRONGLY_CONNECTED_COMPONENTS_PROPERTY_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graph_containers.h"
+
+namespace Graph
+{
+    // One past the largest vertex descriptor of a graph whose descriptors
+    // are non-negative integers.
+    template <typename TGraph>
+    size_t VertexIndexBound(const TGraph& graph)
+    {
+        size_t bound = 0;
+        for (const auto& vertex : graph.Vertices())
+        {
+            bound = std::max(bound, static_cast<size_t>(vertex) + 1);
+        }
+        return bound;
+    }
+
+    // Per-vertex storage indexed directly by the vertex descriptor. Suitable
+    // when descriptors are dense non-negative integers.
+    template <typename Key, typename Value>
+    class VectorPropertyMap
+    {
+    public:
+        using TKey = Key;
+        using TValue = Value;
+
+        VectorPropertyMap()
+            : values_()
+        {}
+
+        template <typename TGraph>
+        void Reset(const TGraph& graph)
+        {
+            values_.assign(VertexIndexBound(graph), TValue());
+        }
+
+        TValue& operator[](const TKey& key)
+        {
+            return values_[static_cast<size_t>(key)];
+        }
+
+        const TValue& operator[](const TKey& key) const
+        {
+            return values_[static_cast<size_t>(key)];
+        }
+
+        size_t ByteSize() const
+        {
+            return values_.capacity() * sizeof(TValue);
+        }
+
+    private:
+        std::vector<TValue> values_;
+    };
+
+    // Dense storage like VectorPropertyMap that never shrinks and resets in
+    // O(1): every slot carries the epoch it was last written in, and slots
+    // from older epochs read as TValue(). Meant for maps reused across many
+    // Compute calls, e.g. through an algorithm workspace.
+    template <typename Key, typename Value>
+    class StampedPropertyMap
+    {
+    public:
+        using TKey = Key;
+        using TValue = Value;
+
+        StampedPropertyMap()
+            : slots_()
+            , epoch_(0)
+            , default_()
+        {}
+
+        template <typename TGraph>
+        void Reset(const TGraph& graph)
+        {
+            size_t bound = VertexIndexBound(graph);
+            if (bound > slots_.size())
+            {
+                slots_.resize(bound);
+            }
+            if (++epoch_ == 0)
+            {
+                for (auto& slot : slots_)
+                {
+                    slot.stamp = 0;
+                }
+                epoch_ = 1;
+            }
+        }
+
+        TValue& operator[](const TKey& key)
+        {
+            auto& slot = slots_[static_cast<size_t>(key)];
+            if (slot.stamp != epoch_)
+            {
+                slot.stamp = epoch_;
+                slot.value = TValue();
+            }
+            return slot.value;
+        }
+
+        const TValue& operator[](const TKey& key) const
+        {
+            const auto& slot = slots_[static_cast<size_t>(key)];
+            return slot.stamp == epoch_ ? slot.value : default_;
+        }
+
+        size_t ByteSize() const
+        {
+            return slots_.capacity() * sizeof(Slot);
+        }
+
+    private:
+        // Stamp next to the value, so a lookup touches one cache line
+        struct Slot
+        {
+            TValue value;
+            uint32_t stamp;
+        };
+
+        std::vector<Slot> slots_;
+        uint32_t epoch_;
+        TValue default_;
+    };
+
+    template <typename TKey, typename TValue, typename THash, typename TEqual,
+        typename TAllocator>
+    size_t DictionaryByteSize(
+        const std::unordered_map<TKey, TValue, THash, TEqual, TAllocator>& map)
+    {
+        // One pointer per bucket plus a node per entry
+        return map.bucket_count() * sizeof(void*) + map.size() *
+            (sizeof(std::pair<const TKey, TValue>) + 2 * sizeof(void*));
+    }
+
+    template <typename TKey, typename TValue, typename THash>
+    size_t DictionaryByteSize(const FlatHashMap<TKey, TValue, THash>& map)
+    {
+        return map.ByteSize();
+    }
+
+    // Per-vertex storage for arbitrary hashable descriptors, in the
+    // Dictionary of the container policy. Like the dense maps, a key never
+    // written reads as TValue(): the const lookup returns a stored default
+    // instead of inserting.
+    template <typename Key, typename Value,
+        typename TContainerPolicy = StandardContainerPolicy>
+    class HashPropertyMap
+    {
+    public:
+        using TKey = Key;
+        using TValue = Value;
+
+        HashPropertyMap()
+            : values_()
+            , default_()
+        {}
+
+        template <typename TGraph>
+        void Reset(const TGraph& graph)
+        {
+            values_.clear();
+            values_.reserve(graph.VertexCount());
+        }
+
+        TValue& operator[](const TKey& key)
+        {
+            return values_[key];
+        }
+
+        const TValue& operator[](const TKey& key) const
+        {
+            auto position = values_.find(key);
+            return position != values_.end() ? position->second : default_;
+        }
+
+        size_t ByteSize() const
+        {
+            return DictionaryByteSize(values_);
+        }
+
+    private:
+        typename TContainerPolicy::template Dictionary<TKey, TValue> values_;
+        TValue default_;
+    };
+
+    struct VectorPropertyMapSelector
+    {
+        template <typename Key, typename Value>
+        using Map = VectorPropertyMap<Key, Value>;
+    };
+
+    struct StampedPropertyMapSelector
+    {
+        template <typename Key, typename Value>
+        using Map = StampedPropertyMap<Key, Value>;
+    };
+
+    template <typename TContainerPolicy>
+    struct BasicHashPropertyMapSelector
+    {
+        template <typename Key, typename Value>
+        using Map = HashPropertyMap<Key, Value, TContainerPolicy>;
+    };
+
+    using HashPropertyMapSelector = BasicHashPropertyMapSelector<StandardContainerPolicy>;
+
+    // Result maps whose nodes come from the open NodePool::Scope
+    using PoolHashPropertyMapSelector = BasicHashPropertyMapSelector<PoolContainerPolicy>;
+
+    // Open-addressing result maps
+    using FlatHashPropertyMapSelector = BasicHashPropertyMapSelector<FlatContainerPolicy>;
+
+    // Graphs whose descriptors are known to be dense specialize this to pick
+    // VectorPropertyMapSelector.
+    template <typename TGraph>
+    struct DefaultPropertyMapSelector
+    {
+        using type = HashPropertyMapSelector;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,191 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_REVERSED_GRAPH_H_
+#define STRONGLY_CONNECTED_COMPONENTS_REVERSED_GRAPH_H_
+
+#include <cstddef>
+#include <iterator>
+
+#include "iterator_tools.h"
+#include "property_map.h"
+
+namespace Graph
+{
+    // Turns an iterator over in-edges into one over the reversed edges, so
+    // that every yielded edge starts at the vertex being expanded.
+    template <typename InEdgeIterator, typename Edge>
+    class ReversedEdgeIterator
+    {
+    public:
+        using TEdge = Edge;
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TEdge;
+        using reference = TEdge;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ArrowProxy<TEdge>;
+
+        ReversedEdgeIterator()
+            : iter_()
+        {}
+
+        explicit ReversedEdgeIterator(InEdgeIterator iter)
+            : iter_(iter)
+        {}
+
+        reference operator * () const
+        {
+            return TEdge(iter_->Target(), iter_->Source());
+        }
+
+        pointer operator -> () const
+        {
+            return pointer(**this);
+        }
+
+        ReversedEdgeIterator<InEdgeIterator, Edge>& operator ++()
+        {
+            ++iter_;
+            return *this;
+        }
+
+        ReversedEdgeIterator<InEdgeIterator, Edge> operator ++(int dummy)
+        {
+            auto aCopy = *this;
+            ++*this;
+            return aCopy;
+        }
+
+        bool operator == (const ReversedEdgeIterator<InEdgeIterator, Edge>& other) const
+        {
+            return iter_ == other.iter_;
+        }
+
+        bool operator != (const ReversedEdgeIterator<InEdgeIterator, Edge>& other) const
+        {
+            return iter_ != other.iter_;
+        }
+
+    private:
+        InEdgeIterator iter_;
+    };
+
+    // Read-only view of a bidirectional graph with every edge reversed,
+    // served from its in-edge lists. Lets forward algorithms run backward
+    // traversals without building a transposed copy.
+    template <typename TGraph>
+    class ReversedGraph
+    {
+    public:
+        using TVertexDescriptor = typename TGraph::TVertexDescriptor;
+        using TEdge = typename TGraph::TEdge;
+
+        using ConstVertexIterator = typename TGraph::ConstVertexIterator;
+        using ConstEdgeIterator = ReversedEdgeIterator<
+            typename TGraph::ConstInEdgeIterator, TEdge>;
+
+        explicit ReversedGraph(const TGraph& graph)
+            : graph_(graph)
+        {}
+
+        const TGraph& GetUnderlyingGraph() const
+        {
+            return graph_;
+        }
+
+        bool IsDirected() const
+        {
+            return graph_.IsDirected();
+        }
+
+        bool AllowParallelEdges() const
+        {
+            return graph_.AllowParallelEdges();
+        }
+
+        size_t VertexCount() const
+        {
+            return graph_.VertexCount();
+        }
+
+        bool IsVerticesEmpty() const
+        {
+            return graph_.IsVerticesEmpty();
+        }
+
+        IteratorRange<ConstVertexIterator> Vertices() const
+        {
+            return graph_.Vertices();
+        }
+
+        bool ContainsVertex(const TVertexDescriptor& vertex) const
+        {
+            return graph_.ContainsVertex(vertex);
+        }
+
+        bool IsOutEdgesEmpty(const TVertexDescriptor& vertex) const
+        {
+            return graph_.IsInEdgesEmpty(vertex);
+        }
+
+        size_t OutDegree(const TVertexDescriptor& vertex) const
+        {
+            return graph_.InDegree(vertex);
+        }
+
+        IteratorRange<ConstEdgeIterator> OutEdges(const TVertexDescriptor& vertex) const
+        {
+            auto inEdges = graph_.InEdges(vertex);
+            return IteratorRange<ConstEdgeIterator>(
+                ConstEdgeIterator(inEdges.begin()), ConstEdgeIterator(inEdges.end()));
+        }
+
+        bool TryGetEdges(const TVertexDescriptor& vertex,
+            IteratorRange<ConstEdgeIterator>& range) const
+        {
+            if (ContainsVertex(vertex))
+            {
+                range = OutEdges(vertex);
+                return true;
+            }
+            return false;
+        }
+
+        size_t EdgeCount() const
+        {
+            return graph_.EdgeCount();
+        }
+
+        bool ContainsEdge(const TVertexDescriptor& source,
+            const TVertexDescriptor& target) const
+        {
+            return graph_.ContainsEdge(target, source);
+        }
+
+        bool ContainsEdge(const TEdge& edge) const
+        {
+            return ContainsEdge(edge.Source(), edge.Target());
+        }
+
+    private:
+        const TGraph& graph_;
+    };
+
+    template <typename TGraph>
+    struct DefaultPropertyMapSelector<ReversedGraph<TGraph>>
+    {
+        using type = typename DefaultPropertyMapSelector<TGraph>::type;
+    };
+
+    template <typename TGraph>
+    struct DefaultContainerPolicy<ReversedGraph<TGraph>>
+    {
+        using type = typename DefaultContainerPolicy<TGraph>::type;
+    };
+
+    template <typename TGraph>
+    ReversedGraph<TGraph> MakeReversedGraph(const TGraph& graph)
+    {
+        return ReversedGraph<TGraph>(graph);
+    }
+}
+
+#endif
\ No newline at end of file
@@ -5,11 +5,11 @@
 
 namespace Graph
 {
-    template <typename TGraph>
-    class RootedAlgorithmBase : public AlgorithmBase<TGraph>
+    template <typename TGraph, typename TStatistics = NoStatistics>
+    class RootedAlgorithmBase : public AlgorithmBase<TGraph, TStatistics>
     {
     public:
-        using BaseType = AlgorithmBase<TGraph>;
+        using BaseType = AlgorithmBase<TGraph, TStatistics>;
         using TVertexDescriptor = typename TGraph::TVertexDescriptor;
 
         explicit RootedAlgorithmBase(const TGraph& graph)
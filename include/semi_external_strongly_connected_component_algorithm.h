@@ -0,0 +1,400 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_SEMI_EXTERNAL_STRONGLY_CONNECTED_COMPONENT_ALGORITHM_H_
+#define STRONGLY_CONNECTED_COMPONENTS_SEMI_EXTERNAL_STRONGLY_CONNECTED_COMPONENT_ALGORITHM_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "edge.h"
+#include "binary_graph_format.h"
+#include "compressed_sparse_row_graph.h"
+#include "strongly_connected_component_algorithm.h"
+
+namespace Graph
+{
+    // Sequential reader of one array section of a binary graph file, in
+    // blocks of a fixed size. Every byte read is added to bytesRead; going
+    // past readBudget (0 = unlimited) throws.
+    template <typename TValue>
+    class BinaryBlockReader
+    {
+    public:
+        BinaryBlockReader(const std::string& path, uint64_t sectionOffset, uint64_t count,
+            size_t blockBytes, uint64_t& bytesRead, uint64_t readBudget)
+            : in_(path, std::ios::binary)
+            , buffer_(std::max<size_t>(1, blockBytes / sizeof(TValue)))
+            , position_(0)
+            , size_(0)
+            , remaining_(count)
+            , bytesRead_(bytesRead)
+            , readBudget_(readBudget)
+        {
+            if (!in_)
+            {
+                throw std::runtime_error("cannot open '" + path + "'");
+            }
+            in_.seekg(static_cast<std::streamoff>(sectionOffset));
+        }
+
+        TValue Next()
+        {
+            if (position_ == size_)
+            {
+                Refill();
+            }
+            return buffer_[position_++];
+        }
+
+    private:
+        void Refill()
+        {
+            size_ = static_cast<size_t>(std::min<uint64_t>(buffer_.size(), remaining_));
+            if (size_ == 0)
+            {
+                throw std::runtime_error("binary graph section ended early");
+            }
+            size_t bytes = size_ * sizeof(TValue);
+            if (readBudget_ != 0 && bytesRead_ + bytes > readBudget_)
+            {
+                throw std::runtime_error("semi-external read budget exhausted");
+            }
+            in_.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(bytes));
+            if (static_cast<size_t>(in_.gcount()) != bytes)
+            {
+                throw std::runtime_error("cannot read binary graph section");
+            }
+            bytesRead_ += bytes;
+            remaining_ -= size_;
+            position_ = 0;
+        }
+
+    private:
+        std::ifstream in_;
+        std::vector<TValue> buffer_;
+        size_t position_;
+        size_t size_;
+        uint64_t remaining_;
+        uint64_t& bytesRead_;
+        uint64_t readBudget_;
+    };
+
+    // Strongly connected components of a graph in the binary file format
+    // of WriteBinaryGraph whose edges need not fit in memory. Only a color
+    // and a component id per vertex stay resident; the offsets and targets
+    // are streamed sequentially, block by block, once per pass.
+    //
+    // Coloring algorithm (Orzan): every remaining vertex takes the largest
+    // id that reaches it, by propagating along the edges until a pass
+    // changes nothing. A vertex whose color is its own id is a root, and
+    // its component is what reaches it backwards inside its color, found by
+    // further passes. Each round settles at least one component. As soon as
+    // the edges among the remaining vertices fit the memory budget, they
+    // are loaded once and the rest is finished in memory with Tarjan's
+    // algorithm.
+    //
+    // Passes per round grow with the longest path that runs against the
+    // id order, so a giant component is cheap while a long chain of small
+    // components kept out of memory is not. Component ids are dense but not
+    // topologically ordered.
+    template <typename VertexDescriptor>
+    class SemiExternalStronglyConnectedComponentAlgorithm
+    {
+        static_assert(std::is_integral<VertexDescriptor>::value,
+            "SemiExternalStronglyConnectedComponentAlgorithm requires integral vertex descriptors");
+
+    public:
+        using TVertexDescriptor = VertexDescriptor;
+
+        static constexpr size_t kDefaultBlockBytes = 1 << 20;
+
+        // memoryBudget bounds the resident per-vertex arrays, the two block
+        // buffers and any edges loaded for the in-memory finish
+        SemiExternalStronglyConnectedComponentAlgorithm(const std::string& path,
+            size_t memoryBudget)
+            : path_(path)
+            , memoryBudget_(memoryBudget)
+            , blockBytes_(kDefaultBlockBytes)
+            , readBudget_(0)
+            , header_()
+            , colors_()
+            , components_()
+            , componentsCount_(0)
+            , bytesRead_(0)
+            , passCount_(0)
+            , roundCount_(0)
+        {}
+
+        // Size of every sequential read, per stream
+        void SetBlockBytes(size_t blockBytes)
+        {
+            blockBytes_ = std::max<size_t>(blockBytes, sizeof(uint64_t));
+        }
+
+        // Total bytes a Compute call may read, headers included; 0 lifts
+        // the limit
+        void SetReadBudget(uint64_t readBudget)
+        {
+            readBudget_ = readBudget;
+        }
+
+        void Compute()
+        {
+            bytesRead_ = 0;
+            passCount_ = 0;
+            roundCount_ = 0;
+            ReadHeader();
+            size_t vertexCount = static_cast<size_t>(header_.vertexCount);
+            size_t residentBytes = vertexCount * kStateBytesPerVertex + 2 * blockBytes_;
+            if (residentBytes > memoryBudget_)
+            {
+                throw std::runtime_error("semi-external memory budget is below the "
+                    "per-vertex state and block buffers");
+            }
+
+            colors_.assign(vertexCount, TVertexDescriptor(0));
+            components_.assign(vertexCount, kNoComponent);
+            componentsCount_ = 0;
+            size_t activeCount = vertexCount;
+            while (activeCount > 0)
+            {
+                ++roundCount_;
+                for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+                {
+                    if (IsActive(vertex))
+                    {
+                        colors_[vertex] = TVertexDescriptor(vertex);
+                    }
+                }
+
+                // The first pass also sizes what is left
+                uint64_t activeEdgeCount = 0;
+                bool changed = Scan([this, &activeEdgeCount](size_t source, size_t target)
+                {
+                    if (!IsActive(source) || !IsActive(target))
+                    {
+                        return false;
+                    }
+                    ++activeEdgeCount;
+                    return Propagate(source, target);
+                });
+                if (residentBytes + activeEdgeCount * kResidualBytesPerEdge +
+                    activeCount * kResidualBytesPerVertex <= memoryBudget_)
+                {
+                    FinishInMemory(activeCount, activeEdgeCount);
+                    break;
+                }
+                while (changed)
+                {
+                    changed = Scan([this](size_t source, size_t target)
+                    {
+                        return IsActive(source) && IsActive(target) &&
+                            Propagate(source, target);
+                    });
+                }
+
+                for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+                {
+                    if (IsActive(vertex) && static_cast<size_t>(colors_[vertex]) == vertex)
+                    {
+                        components_[vertex] = componentsCount_++;
+                        --activeCount;
+                    }
+                }
+                // Settled vertices of earlier rounds hold colors of settled
+                // roots, which no active vertex can carry any more
+                do
+                {
+                    size_t activeBefore = activeCount;
+                    Scan([this, &activeCount](size_t source, size_t target)
+                    {
+                        if (IsActive(source) && !IsActive(target) &&
+                            colors_[source] == colors_[target])
+                        {
+                            components_[source] = components_[target];
+                            --activeCount;
+                            return true;
+                        }
+                        return false;
+                    });
+                    changed = activeCount != activeBefore;
+                } while (changed);
+            }
+        }
+
+        // Indexed by vertex descriptor
+        const std::vector<size_t>& GetComponents() const
+        {
+            return components_;
+        }
+
+        size_t GetComponentsCount() const
+        {
+            return componentsCount_;
+        }
+
+        // Of the last Compute call
+        uint64_t GetBytesRead() const
+        {
+            return bytesRead_;
+        }
+
+        size_t GetPassCount() const
+        {
+            return passCount_;
+        }
+
+        size_t GetRoundCount() const
+        {
+            return roundCount_;
+        }
+
+    private:
+        static constexpr size_t kNoComponent = std::numeric_limits<size_t>::max();
+        static constexpr size_t kStateBytesPerVertex =
+            sizeof(TVertexDescriptor) + sizeof(size_t);
+        // Edge list plus CSR targets, and offsets plus Tarjan's maps
+        static constexpr size_t kResidualBytesPerEdge = 3 * sizeof(size_t);
+        static constexpr size_t kResidualBytesPerVertex = 8 * sizeof(size_t);
+
+        bool IsActive(size_t vertex) const
+        {
+            return components_[vertex] == kNoComponent;
+        }
+
+        bool Propagate(size_t source, size_t target)
+        {
+            if (colors_[target] < colors_[source])
+            {
+                colors_[target] = colors_[source];
+                return true;
+            }
+            return false;
+        }
+
+        void ReadHeader()
+        {
+            std::ifstream in(path_, std::ios::binary | std::ios::ate);
+            if (!in)
+            {
+                throw std::runtime_error("cannot open '" + path_ + "'");
+            }
+            auto fileSize = static_cast<size_t>(in.tellg());
+            in.seekg(0);
+            if (fileSize < sizeof(BinaryGraphHeader) ||
+                !in.read(reinterpret_cast<char*>(&header_), sizeof(header_)))
+            {
+                throw std::runtime_error("'" + path_ + "' is too small for a binary graph");
+            }
+            ValidateBinaryGraphHeader(header_, fileSize, sizeof(TVertexDescriptor));
+            bytesRead_ += sizeof(header_);
+        }
+
+        // One sequential pass over every edge; true when func returned true
+        // for any of them. The file is not trusted: every offset and target
+        // is checked as it streams by, before it can index the vertex state.
+        template <typename TFunc>
+        bool Scan(TFunc func)
+        {
+            ++passCount_;
+            uint64_t offsetsStart = sizeof(BinaryGraphHeader);
+            uint64_t targetsStart = offsetsStart + (header_.vertexCount + 1) * sizeof(uint64_t);
+            BinaryBlockReader<uint64_t> offsets(path_, offsetsStart, header_.vertexCount + 1,
+                blockBytes_, bytesRead_, readBudget_);
+            BinaryBlockReader<TVertexDescriptor> targets(path_, targetsStart, header_.edgeCount,
+                blockBytes_, bytesRead_, readBudget_);
+            bool any = false;
+            uint64_t begin = offsets.Next();
+            if (begin != 0)
+            {
+                throw std::runtime_error("binary graph offsets do not start at 0");
+            }
+            for (size_t vertex = 0; vertex < header_.vertexCount; ++vertex)
+            {
+                uint64_t end = offsets.Next();
+                if (end < begin)
+                {
+                    throw std::runtime_error("binary graph offsets decrease at vertex " +
+                        std::to_string(vertex));
+                }
+                for (uint64_t edge = begin; edge < end; ++edge)
+                {
+                    TVertexDescriptor target = targets.Next();
+                    if (target < TVertexDescriptor(0) ||
+                        static_cast<uint64_t>(target) >= header_.vertexCount)
+                    {
+                        throw std::runtime_error("binary graph target " + std::to_string(edge) +
+                            " is not a vertex");
+                    }
+                    any = func(vertex, static_cast<size_t>(target)) || any;
+                }
+                begin = end;
+            }
+            if (begin != header_.edgeCount)
+            {
+                throw std::runtime_error("binary graph offsets do not end at the edge count");
+            }
+            return any;
+        }
+
+        // Loads the edges among active vertices, renumbered densely through
+        // colors_, and runs Tarjan on them
+        void FinishInMemory(size_t activeCount, uint64_t activeEdgeCount)
+        {
+            using TIndexGraph = CompressedSparseRowGraph<size_t, Edge<size_t>>;
+
+            std::vector<size_t> vertices;
+            vertices.reserve(activeCount);
+            for (size_t vertex = 0; vertex < colors_.size(); ++vertex)
+            {
+                if (IsActive(vertex))
+                {
+                    colors_[vertex] = TVertexDescriptor(vertices.size());
+                    vertices.push_back(vertex);
+                }
+            }
+            std::vector<Edge<size_t>> edges;
+            edges.reserve(static_cast<size_t>(activeEdgeCount));
+            Scan([this, &edges](size_t source, size_t target)
+            {
+                if (IsActive(source) && IsActive(target))
+                {
+                    edges.emplace_back(static_cast<size_t>(colors_[source]),
+                        static_cast<size_t>(colors_[target]));
+                }
+                return false;
+            });
+            TIndexGraph graph(vertices.size(), edges.begin(), edges.end());
+            edges = std::vector<Edge<size_t>>();
+
+            StronglyConnectedComponentAlgorithm<TIndexGraph> algo(graph);
+            algo.Compute();
+            const auto& components = algo.GetComponents();
+            for (size_t index = 0; index < vertices.size(); ++index)
+            {
+                components_[vertices[index]] = componentsCount_ + components[index];
+            }
+            componentsCount_ += algo.GetComponentsCount();
+        }
+
+    private:
+        std::string path_;
+        size_t memoryBudget_;
+        size_t blockBytes_;
+        uint64_t readBudget_;
+        BinaryGraphHeader header_;
+        std::vector<TVertexDescriptor> colors_;
+        std::vector<size_t> components_;
+        size_t componentsCount_;
+        uint64_t bytesRead_;
+        size_t passCount_;
+        size_t roundCount_;
+    };
+}
+
+#endif
\ No newline at end of file
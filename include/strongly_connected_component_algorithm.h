@@ -1,51 +1,154 @@
 #ifndef STRONGLY_CONNECTED_COMPONENTS_STRONGLY_CONNECTED_COMPONENT_ALGORITHM_H_
 #define STRONGLY_CONNECTED_COMPONENTS_STRONGLY_CONNECTED_COMPONENT_ALGORITHM_H_
 
-#include <memory>
+#include <limits>
 
-#include "vertex_action.h"
-#include "edge_action.h"
 #include "graph_containers.h"
+#include "property_map.h"
 #include "algorithm_base.h"
+#include "filtered_graph.h"
+#include "trim_algorithm.h"
+#include "depth_first_search_visitor.h"
 #include "depth_first_search_algorithm.h"
 
 namespace Graph
 {
-    template <typename TGraph>
-    class StronglyConnectedComponentAlgorithm : public AlgorithmBase<TGraph>
+    // Result maps, vertex stack and search storage of
+    // StronglyConnectedComponentAlgorithm. Handing one workspace to every
+    // algorithm in a loop over many graphs of the same type keeps all of it
+    // allocated at the size of the largest graph so far; with
+    // StampedPropertyMapSelector the maps are also cleared in O(1).
+    template <typename TGraph, typename TPropertyMapSelector =
+        typename DefaultPropertyMapSelector<TGraph>::type, typename TContainerPolicy =
+            typename DefaultContainerPolicy<TGraph>::type>
+    class StronglyConnectedComponentWorkspace
     {
     public:
-        using BaseType = AlgorithmBase<TGraph>;
         using TVertexDescriptor = typename TGraph::TVertexDescriptor;
-        using TEdge = typename TGraph::TEdge;
+        using TComponentMap = typename TPropertyMapSelector::template Map<
+            TVertexDescriptor, size_t>;
+        using TRootMap = typename TPropertyMapSelector::template Map<
+            TVertexDescriptor, TVertexDescriptor>;
+        using TVertexStack = typename TContainerPolicy::template Stack<TVertexDescriptor>;
+        using TSearchWorkspace = DepthFirstSearchWorkspace<TGraph, TPropertyMapSelector,
+            TContainerPolicy>;
 
-        explicit StronglyConnectedComponentAlgorithm(const TGraph& graph)
-            : BaseType(graph)
-            , components_()
+        StronglyConnectedComponentWorkspace()
+            : components_()
             , discoverTimes_()
             , roots_()
             , stack_()
+            , search_()
+        {}
+
+        TComponentMap& Components()
+        {
+            return components_;
+        }
+
+        const TComponentMap& Components() const
+        {
+            return components_;
+        }
+
+        TComponentMap& DiscoverTimes()
+        {
+            return discoverTimes_;
+        }
+
+        const TComponentMap& DiscoverTimes() const
+        {
+            return discoverTimes_;
+        }
+
+        TRootMap& Roots()
+        {
+            return roots_;
+        }
+
+        const TRootMap& Roots() const
+        {
+            return roots_;
+        }
+
+        TVertexStack& Stack()
+        {
+            return stack_;
+        }
+
+        TSearchWorkspace& Search()
+        {
+            return search_;
+        }
+
+    private:
+        TComponentMap components_;
+        TComponentMap discoverTimes_;
+        TRootMap roots_;
+        TVertexStack stack_;
+        TSearchWorkspace search_;
+    };
+
+    template <typename TGraph, typename TPropertyMapSelector =
+        typename DefaultPropertyMapSelector<TGraph>::type,
+        typename TStatistics = NoStatistics, typename TContainerPolicy =
+            typename DefaultContainerPolicy<TGraph>::type>
+    class StronglyConnectedComponentAlgorithm :
+        public AlgorithmBase<TGraph, TStatistics>
+    {
+    public:
+        using BaseType = AlgorithmBase<TGraph, TStatistics>;
+        using TVertexDescriptor = typename TGraph::TVertexDescriptor;
+        using TEdge = typename TGraph::TEdge;
+        using TWorkspace = StronglyConnectedComponentWorkspace<TGraph,
+            TPropertyMapSelector, TContainerPolicy>;
+        using TComponentMap = typename TWorkspace::TComponentMap;
+        using TRootMap = typename TWorkspace::TRootMap;
+
+        explicit StronglyConnectedComponentAlgorithm(const TGraph& graph)
+            : BaseType(graph)
+            , ownWorkspace_()
+            , workspace_(nullptr)
+            , componentsCount_(0)
+            , dfsTime_(0)
+            , trimming_(false)
+            , trimThreadCount_(1)
+        {}
+
+        // Borrows the storage of workspace, which must outlive the
+        // algorithm; the result maps stay valid until it is used again
+        StronglyConnectedComponentAlgorithm(const TGraph& graph, TWorkspace& workspace)
+            : BaseType(graph)
+            , ownWorkspace_()
+            , workspace_(&workspace)
             , componentsCount_(0)
             , dfsTime_(0)
+            , trimming_(false)
+            , trimThreadCount_(1)
         {}
 
-        std::shared_ptr<Dictionary<TVertexDescriptor, size_t>>
-            GetComponents() const
+        // When enabled, vertices that TrimAlgorithm can peel get singleton
+        // components (numbered first) and only the rest is searched.
+        void SetTrimming(bool trimming, size_t threadCount = 1)
         {
-                return components_;
-            }
+            trimming_ = trimming;
+            trimThreadCount_ = threadCount;
+        }
 
-        std::shared_ptr<Dictionary<TVertexDescriptor, TVertexDescriptor>>
-            GetRoots() const
+        const TComponentMap& GetComponents() const
         {
-                return roots_;
-            }
+            return GetWorkspace().Components();
+        }
 
-        std::shared_ptr<Dictionary<TVertexDescriptor, size_t>>
-            GetDiscoverTimes() const
+        const TRootMap& GetRoots() const
         {
-                return discoverTimes_;
-            }
+            return GetWorkspace().Roots();
+        }
+
+        const TComponentMap& GetDiscoverTimes() const
+        {
+            return GetWorkspace().DiscoverTimes();
+        }
 
         size_t GetComponentsCount() const
         {
@@ -55,35 +158,130 @@ namespace Graph
     protected:
         void Initialize() override
         {
-            components_ = std::make_shared < Dictionary < TVertexDescriptor,
-                size_t >> ();
-            discoverTimes_ = std::make_shared < Dictionary < TVertexDescriptor,
-                size_t >> ();
-            roots_ = std::make_shared < Dictionary < TVertexDescriptor,
-                TVertexDescriptor >> ();
+            auto& workspace = GetWorkspace();
+            workspace.Components().Reset(BaseType::GetGraph());
+            workspace.DiscoverTimes().Reset(BaseType::GetGraph());
+            workspace.Roots().Reset(BaseType::GetGraph());
+            // Left over only if a previous run was interrupted
+            while (!workspace.Stack().empty())
+            {
+                workspace.Stack().pop();
+            }
             componentsCount_ = 0;
             dfsTime_ = 0;
         }
 
         void InternalCompute() override
         {
-            auto dfs = DepthFirstSearchAlgorithm<TGraph>(BaseType::GetGraph());
-            dfs.SetDiscoverVertexAction(
-                [this](const TVertexDescriptor& vertex)
+            const auto& graph = BaseType::GetGraph();
+            if (!trimming_)
+            {
+                Search(graph);
+                return;
+            }
+
+            TrimAlgorithm<TGraph, TPropertyMapSelector> trim(graph, trimThreadCount_);
+            trim.Compute();
+            const auto& trimmed = trim.GetComponents();
+            auto& components = GetWorkspace().Components();
+            for (const auto& vertex : graph.Vertices())
+            {
+                components[vertex] = trimmed[vertex];
+            }
+            componentsCount_ = trim.GetComponentsCount();
+            Search(MakeFilteredGraph(graph, UntrimmedPredicate(trim)));
+        }
+
+    private:
+        using TTrimAlgorithm = TrimAlgorithm<TGraph, TPropertyMapSelector>;
+
+        class UntrimmedPredicate
+        {
+        public:
+            UntrimmedPredicate()
+                : trim_(nullptr)
+            {}
+
+            explicit UntrimmedPredicate(const TTrimAlgorithm& trim)
+                : trim_(&trim)
+            {}
+
+            bool operator()(const TVertexDescriptor& vertex) const
+            {
+                return !trim_->IsTrimmed(vertex);
+            }
+
+        private:
+            const TTrimAlgorithm* trim_;
+        };
+
+        TWorkspace& GetWorkspace()
+        {
+            return workspace_ != nullptr ? *workspace_ : ownWorkspace_;
+        }
+
+        const TWorkspace& GetWorkspace() const
+        {
+            return workspace_ != nullptr ? *workspace_ : ownWorkspace_;
+        }
+
+        // The finish hook rescans out-edges on the unfiltered graph; trimmed
+        // targets already own a component and are skipped there. The search
+        // of a trimmed graph brings its own storage.
+        template <typename TSearchGraph>
+        void Search(const TSearchGraph& searchGraph)
+        {
+            auto dfs = DepthFirstSearchAlgorithm<TSearchGraph, TPropertyMapSelector,
+                ComponentVisitor, TStatistics, TContainerPolicy>(searchGraph,
+                ComponentVisitor(*this));
+            dfs.Compute();
+            RecordSearch(dfs.GetStatistics());
+        }
+
+        void Search(const TGraph& graph)
+        {
+            auto dfs = DepthFirstSearchAlgorithm<TGraph, TPropertyMapSelector,
+                ComponentVisitor, TStatistics, TContainerPolicy>(graph,
+                GetWorkspace().Search(), ComponentVisitor(*this));
+            dfs.Compute();
+            RecordSearch(dfs.GetStatistics());
+        }
+
+        void RecordSearch(const TStatistics& searchStatistics)
+        {
+            const auto& workspace = GetWorkspace();
+            auto& statistics = BaseType::Statistics();
+            statistics.Merge(searchStatistics);
+            statistics.ResultBytes(workspace.Components().ByteSize() +
+                workspace.DiscoverTimes().ByteSize() + workspace.Roots().ByteSize());
+        }
+
+        class ComponentVisitor : public DepthFirstSearchVisitor
+        {
+        public:
+            explicit ComponentVisitor(StronglyConnectedComponentAlgorithm& algorithm)
+                : algorithm_(&algorithm)
+                , workspace_(&algorithm.GetWorkspace())
+            {}
+
+            void DiscoverVertex(const TVertexDescriptor& vertex)
             {
-                (*roots_)[vertex] = vertex;
-                (*components_)[vertex] = std::numeric_limits<size_t>::max();
-                (*discoverTimes_)[vertex] = dfsTime_++;
-                stack_.push(vertex);
-            });
-            dfs.SetFinishVertexAction(
-                [this](const TVertexDescriptor& vertex)
+                auto& workspace = *workspace_;
+                workspace.Roots()[vertex] = vertex;
+                workspace.Components()[vertex] = std::numeric_limits<size_t>::max();
+                workspace.DiscoverTimes()[vertex] = algorithm_->dfsTime_++;
+                workspace.Stack().push(vertex);
+            }
+
+            void FinishVertex(const TVertexDescriptor& vertex)
             {
-                auto& components = *components_.get();
-                auto& roots = *roots_.get();
-                auto& discoverTimes = *discoverTimes_.get();
+                auto& algorithm = *algorithm_;
+                auto& components = workspace_->Components();
+                auto& roots = workspace_->Roots();
+                auto& discoverTimes = workspace_->DiscoverTimes();
+                auto& stack = workspace_->Stack();
 
-                auto outEdges = BaseType::GetGraph().OutEdges(vertex);
+                auto outEdges = algorithm.GetGraph().OutEdges(vertex);
                 for (auto iedge = outEdges.begin();
                     iedge != outEdges.end();
                     ++iedge)
@@ -105,23 +303,25 @@ namespace Graph
                     TVertexDescriptor otherVertex;
                     do
                     {
-                        otherVertex = stack_.top();
-                        stack_.pop();
-                        components[otherVertex] = componentsCount_;
+                        otherVertex = stack.top();
+                        stack.pop();
+                        components[otherVertex] = algorithm.componentsCount_;
                     } while (otherVertex != vertex);
-                    ++componentsCount_;
+                    ++algorithm.componentsCount_;
                 }
-            });
-            dfs.Compute();
-        }
+            }
 
-    private:
-        std::shared_ptr<Dictionary<TVertexDescriptor, size_t>> components_;
-        std::shared_ptr<Dictionary<TVertexDescriptor, size_t>> discoverTimes_;
-        std::shared_ptr<Dictionary<TVertexDescriptor, TVertexDescriptor>> roots_;
-        Stack<TVertexDescriptor> stack_;
+        private:
+            StronglyConnectedComponentAlgorithm* algorithm_;
+            TWorkspace* workspace_;
+        };
+
+        TWorkspace ownWorkspace_;
+        TWorkspace* workspace_;
         size_t componentsCount_;
         size_t dfsTime_;
+        bool trimming_;
+        size_t trimThreadCount_;
     };
 }
 
@@ -0,0 +1,204 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_TRIM_ALGORITHM_H_
+#define STRONGLY_CONNECTED_COMPONENTS_TRIM_ALGORITHM_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "edge.h"
+#include "property_map.h"
+#include "vertex_index_map.h"
+#include "compressed_sparse_row_graph.h"
+#include "work_stealing_thread_pool.h"
+#include "algorithm_base.h"
+
+namespace Graph
+{
+    // Repeatedly peels vertices whose in-degree or out-degree (self-loops
+    // not counted) is zero among the remaining vertices. Every peeled vertex
+    // is a strongly connected component on its own and gets the next
+    // component id in peeling order; the rest keep kUntrimmed.
+    //
+    // Peeling runs in rounds, so with threadCount > 1 each round is spread
+    // over a work-stealing pool.
+    template <typename TGraph, typename TPropertyMapSelector =
+        typename DefaultPropertyMapSelector<TGraph>::type>
+    class TrimAlgorithm : public AlgorithmBase<TGraph>
+    {
+    public:
+        using BaseType = AlgorithmBase<TGraph>;
+        using TVertexDescriptor = typename TGraph::TVertexDescriptor;
+        using TEdge = typename TGraph::TEdge;
+        using TComponentMap = typename TPropertyMapSelector::template Map<
+            TVertexDescriptor, size_t>;
+
+        static constexpr size_t kUntrimmed = std::numeric_limits<size_t>::max();
+
+        explicit TrimAlgorithm(const TGraph& graph, size_t threadCount = 1)
+            : BaseType(graph)
+            , threadCount_(threadCount)
+            , components_()
+            , componentsCount_(0)
+        {}
+
+        void SetThreadCount(size_t threadCount)
+        {
+            threadCount_ = threadCount;
+        }
+
+        const TComponentMap& GetComponents() const
+        {
+            return components_;
+        }
+
+        size_t GetComponentsCount() const
+        {
+            return componentsCount_;
+        }
+
+        bool IsTrimmed(const TVertexDescriptor& vertex) const
+        {
+            return components_[vertex] != kUntrimmed;
+        }
+
+    protected:
+        void Initialize() override
+        {
+            components_.Reset(BaseType::GetGraph());
+            componentsCount_ = 0;
+        }
+
+        void InternalCompute() override
+        {
+            const auto& graph = BaseType::GetGraph();
+            VertexIndexMap<TGraph, TPropertyMapSelector> indices(graph);
+            IndexGraph forward = MakeCompressedSparseRowGraph(graph, indices);
+            IndexGraph backward = MakeTransposedGraph(forward);
+            size_t vertexCount = indices.VertexCount();
+
+            std::unique_ptr<WorkStealingThreadPool> pool;
+            if (threadCount_ > 1)
+            {
+                pool.reset(new WorkStealingThreadPool(threadCount_));
+            }
+            auto forEachChunk = [&pool](size_t count,
+                std::function<void(size_t, size_t)> func)
+            {
+                if (pool)
+                {
+                    ParallelFor(*pool, 0, count, kParallelGrain, func);
+                }
+                else
+                {
+                    func(0, count);
+                }
+            };
+
+            std::unique_ptr<std::atomic<size_t>[]> inDegrees(
+                new std::atomic<size_t>[vertexCount]);
+            std::unique_ptr<std::atomic<size_t>[]> outDegrees(
+                new std::atomic<size_t>[vertexCount]);
+            std::unique_ptr<std::atomic<bool>[]> removed(
+                new std::atomic<bool>[vertexCount]);
+            std::vector<size_t> componentOf(vertexCount, kUntrimmed);
+            std::vector<size_t> frontier;
+            std::mutex frontierMutex;
+
+            forEachChunk(vertexCount, [&](size_t begin, size_t end)
+            {
+                std::vector<size_t> local;
+                for (size_t vertex = begin; vertex < end; ++vertex)
+                {
+                    inDegrees[vertex] = CountNeighbors(backward, vertex);
+                    outDegrees[vertex] = CountNeighbors(forward, vertex);
+                    removed[vertex] = inDegrees[vertex] == 0 || outDegrees[vertex] == 0;
+                    if (removed[vertex])
+                    {
+                        local.push_back(vertex);
+                    }
+                }
+                std::lock_guard<std::mutex> lock(frontierMutex);
+                frontier.insert(frontier.end(), local.begin(), local.end());
+            });
+
+            std::vector<size_t> next;
+            while (!frontier.empty())
+            {
+                for (auto vertex : frontier)
+                {
+                    componentOf[vertex] = componentsCount_++;
+                }
+                next.clear();
+                forEachChunk(frontier.size(), [&](size_t begin, size_t end)
+                {
+                    std::vector<size_t> local;
+                    for (size_t position = begin; position < end; ++position)
+                    {
+                        size_t vertex = frontier[position];
+                        Unlink(forward, vertex, inDegrees.get(), removed.get(), local);
+                        Unlink(backward, vertex, outDegrees.get(), removed.get(), local);
+                    }
+                    std::lock_guard<std::mutex> lock(frontierMutex);
+                    next.insert(next.end(), local.begin(), local.end());
+                });
+                frontier.swap(next);
+            }
+
+            for (size_t index = 0; index < vertexCount; ++index)
+            {
+                components_[indices.VertexAt(index)] = componentOf[index];
+            }
+        }
+
+    private:
+        using IndexGraph = CompressedSparseRowGraph<size_t, Edge<size_t>>;
+
+        static constexpr size_t kParallelGrain = 1024;
+
+        static size_t CountNeighbors(const IndexGraph& graph, size_t vertex)
+        {
+            size_t count = 0;
+            for (const auto& edge : graph.OutEdges(vertex))
+            {
+                if (edge.Target() != vertex)
+                {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        // Drops the edges between a peeled vertex and its neighbors, claiming
+        // every neighbor whose degree falls to zero for the next round
+        static void Unlink(const IndexGraph& graph, size_t vertex,
+            std::atomic<size_t>* degrees, std::atomic<bool>* removed,
+            std::vector<size_t>& next)
+        {
+            for (const auto& edge : graph.OutEdges(vertex))
+            {
+                size_t neighbor = edge.Target();
+                if (neighbor == vertex || removed[neighbor].load(std::memory_order_relaxed))
+                {
+                    continue;
+                }
+                bool expected = false;
+                if (degrees[neighbor].fetch_sub(1, std::memory_order_relaxed) == 1 &&
+                    removed[neighbor].compare_exchange_strong(expected, true))
+                {
+                    next.push_back(neighbor);
+                }
+            }
+        }
+
+    private:
+        size_t threadCount_;
+        TComponentMap components_;
+        size_t componentsCount_;
+    };
+}
+
+#endif
\ No newline at end of file
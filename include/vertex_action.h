@@ -28,6 +28,11 @@ namespace Graph
             }
         }
 
+        explicit operator bool() const
+        {
+            return static_cast<bool>(action_);
+        }
+
     private:
         std::function<void(const TVertexDescriptor&)> action_;
     };
@@ -0,0 +1,61 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_VERTEX_INDEX_MAP_H_
+#define STRONGLY_CONNECTED_COMPONENTS_VERTEX_INDEX_MAP_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "property_map.h"
+
+namespace Graph
+{
+    // Numbers the vertices of a graph 0..VertexCount()-1 in the order the
+    // graph enumerates them, and translates in both directions.
+    template <typename TGraph, typename TPropertyMapSelector =
+        typename DefaultPropertyMapSelector<TGraph>::type>
+    class VertexIndexMap
+    {
+    public:
+        using TVertexDescriptor = typename TGraph::TVertexDescriptor;
+        using TIndexMap = typename TPropertyMapSelector::template Map<
+            TVertexDescriptor, size_t>;
+
+        explicit VertexIndexMap(const TGraph& graph)
+            : vertices_()
+            , indices_()
+        {
+            vertices_.reserve(graph.VertexCount());
+            indices_.Reset(graph);
+            for (const auto& vertex : graph.Vertices())
+            {
+                indices_[vertex] = vertices_.size();
+                vertices_.push_back(vertex);
+            }
+        }
+
+        size_t VertexCount() const
+        {
+            return vertices_.size();
+        }
+
+        size_t IndexOf(const TVertexDescriptor& vertex) const
+        {
+            return indices_[vertex];
+        }
+
+        const TVertexDescriptor& VertexAt(size_t index) const
+        {
+            return vertices_[index];
+        }
+
+        const std::vector<TVertexDescriptor>& Vertices() const
+        {
+            return vertices_;
+        }
+
+    private:
+        std::vector<TVertexDescriptor> vertices_;
+        TIndexMap indices_;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,290 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_VERTEX_REORDERING_H_
+#define STRONGLY_CONNECTED_COMPONENTS_VERTEX_REORDERING_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "edge.h"
+#include "property_map.h"
+#include "vertex_index_map.h"
+#include "compressed_sparse_row_graph.h"
+
+namespace Graph
+{
+    enum VertexOrder
+    {
+        // Enumeration order of the source graph
+        ORIGINAL_ORDER,
+        // Breadth-first along out-edges, each tree started at the lowest
+        // unvisited vertex
+        BFS_ORDER,
+        // Reverse Cuthill-McKee over in- and out-neighbors: BFS from a
+        // minimum degree vertex, neighbors by increasing degree, reversed
+        REVERSE_CUTHILL_MCKEE_ORDER,
+        // Decreasing in- plus out-degree, so hubs share cache lines
+        DEGREE_ORDER,
+        VERTEX_ORDER_COUNT
+    };
+
+    inline const char* VertexOrderName(VertexOrder order)
+    {
+        static const char* const kNames[VERTEX_ORDER_COUNT] = {
+            "original", "bfs", "rcm", "degree" };
+        return kNames[order];
+    }
+
+    // Relabels the vertices of any graph as [0, VertexCount()) in the chosen
+    // order and freezes the result as a compact CSR graph. The permutation
+    // is kept, so results computed on the compact graph (e.g. components)
+    // map back to the original descriptors. The graph must outlive this.
+    template <typename TGraph, typename TIndex = size_t, typename TPropertyMapSelector =
+        typename DefaultPropertyMapSelector<TGraph>::type>
+    class VertexReordering
+    {
+    public:
+        using TVertexDescriptor = typename TGraph::TVertexDescriptor;
+        using TCompactGraph = CompressedSparseRowGraph<TIndex, Edge<TIndex>>;
+
+        VertexReordering(const TGraph& graph, VertexOrder order)
+            : graph_(graph)
+            , indices_(graph)
+            , order_()
+            , newIndices_()
+            , compactGraph_()
+        {
+            IndexGraph forward = MakeCompressedSparseRowGraph(graph, indices_);
+            switch (order)
+            {
+            case BFS_ORDER:
+                order_ = BreadthFirstOrder(forward);
+                break;
+            case REVERSE_CUTHILL_MCKEE_ORDER:
+                order_ = ReverseCuthillMcKeeOrder(forward);
+                break;
+            case DEGREE_ORDER:
+                order_ = DegreeOrder(forward);
+                break;
+            default:
+                order_.resize(forward.VertexCount());
+                for (size_t index = 0; index < order_.size(); ++index)
+                {
+                    order_[index] = index;
+                }
+                break;
+            }
+            newIndices_.resize(order_.size());
+            for (size_t position = 0; position < order_.size(); ++position)
+            {
+                newIndices_[order_[position]] = position;
+            }
+            compactGraph_ = Relabel(forward);
+        }
+
+        const TCompactGraph& GetGraph() const
+        {
+            return compactGraph_;
+        }
+
+        size_t VertexCount() const
+        {
+            return order_.size();
+        }
+
+        TIndex NewIndexOf(const TVertexDescriptor& vertex) const
+        {
+            return TIndex(newIndices_[indices_.IndexOf(vertex)]);
+        }
+
+        const TVertexDescriptor& OriginalVertexAt(TIndex index) const
+        {
+            return indices_.VertexAt(order_[static_cast<size_t>(index)]);
+        }
+
+        // Translates a map over the compact graph into one over the
+        // original vertices
+        template <typename TValue, typename TCompactMap>
+        typename TPropertyMapSelector::template Map<TVertexDescriptor, TValue>
+            MapBack(const TCompactMap& compactMap) const
+        {
+            typename TPropertyMapSelector::template Map<TVertexDescriptor, TValue> result;
+            result.Reset(graph_);
+            for (const auto& vertex : graph_.Vertices())
+            {
+                result[vertex] = compactMap[NewIndexOf(vertex)];
+            }
+            return result;
+        }
+
+    private:
+        using IndexGraph = CompressedSparseRowGraph<size_t, Edge<size_t>>;
+
+        static std::vector<size_t> BreadthFirstOrder(const IndexGraph& forward)
+        {
+            const auto& offsets = forward.Offsets();
+            const auto& targets = forward.Targets();
+            size_t vertexCount = forward.VertexCount();
+            std::vector<bool> visited(vertexCount, false);
+            std::vector<size_t> order;
+            order.reserve(vertexCount);
+            for (size_t root = 0; root < vertexCount; ++root)
+            {
+                if (visited[root])
+                {
+                    continue;
+                }
+                visited[root] = true;
+                order.push_back(root);
+                // order doubles as the queue
+                for (size_t head = order.size() - 1; head < order.size(); ++head)
+                {
+                    size_t vertex = order[head];
+                    for (size_t edge = offsets[vertex]; edge < offsets[vertex + 1]; ++edge)
+                    {
+                        size_t next = targets[edge];
+                        if (!visited[next])
+                        {
+                            visited[next] = true;
+                            order.push_back(next);
+                        }
+                    }
+                }
+            }
+            return order;
+        }
+
+        static std::vector<size_t> ReverseCuthillMcKeeOrder(const IndexGraph& forward)
+        {
+            IndexGraph backward = MakeTransposedGraph(forward);
+            size_t vertexCount = forward.VertexCount();
+            std::vector<size_t> degrees(vertexCount);
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                degrees[vertex] = forward.OutDegree(vertex) + backward.OutDegree(vertex);
+            }
+            std::vector<size_t> roots = SortByDegree(degrees, false);
+
+            std::vector<bool> visited(vertexCount, false);
+            std::vector<size_t> order;
+            order.reserve(vertexCount);
+            std::vector<size_t> neighbors;
+            auto byDegree = [&degrees](size_t left, size_t right)
+            {
+                return degrees[left] < degrees[right] ||
+                    (degrees[left] == degrees[right] && left < right);
+            };
+            for (auto root : roots)
+            {
+                if (visited[root])
+                {
+                    continue;
+                }
+                visited[root] = true;
+                order.push_back(root);
+                for (size_t head = order.size() - 1; head < order.size(); ++head)
+                {
+                    size_t vertex = order[head];
+                    neighbors.clear();
+                    CollectUnvisited(forward, vertex, visited, neighbors);
+                    CollectUnvisited(backward, vertex, visited, neighbors);
+                    std::sort(neighbors.begin(), neighbors.end(), byDegree);
+                    order.insert(order.end(), neighbors.begin(), neighbors.end());
+                }
+            }
+            std::reverse(order.begin(), order.end());
+            return order;
+        }
+
+        static void CollectUnvisited(const IndexGraph& graph, size_t vertex,
+            std::vector<bool>& visited, std::vector<size_t>& neighbors)
+        {
+            const auto& offsets = graph.Offsets();
+            const auto& targets = graph.Targets();
+            for (size_t edge = offsets[vertex]; edge < offsets[vertex + 1]; ++edge)
+            {
+                size_t next = targets[edge];
+                if (!visited[next])
+                {
+                    visited[next] = true;
+                    neighbors.push_back(next);
+                }
+            }
+        }
+
+        static std::vector<size_t> DegreeOrder(const IndexGraph& forward)
+        {
+            size_t vertexCount = forward.VertexCount();
+            std::vector<size_t> degrees(vertexCount);
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                degrees[vertex] = forward.OutDegree(vertex);
+            }
+            for (auto target : forward.Targets())
+            {
+                ++degrees[target];
+            }
+            return SortByDegree(degrees, true);
+        }
+
+        // Stable counting sort of the vertex positions
+        static std::vector<size_t> SortByDegree(const std::vector<size_t>& degrees,
+            bool descending)
+        {
+            size_t maxDegree = 0;
+            for (auto degree : degrees)
+            {
+                maxDegree = std::max(maxDegree, degree);
+            }
+            std::vector<size_t> starts(maxDegree + 2, 0);
+            for (auto degree : degrees)
+            {
+                ++starts[(descending ? maxDegree - degree : degree) + 1];
+            }
+            for (size_t bucket = 0; bucket <= maxDegree; ++bucket)
+            {
+                starts[bucket + 1] += starts[bucket];
+            }
+            std::vector<size_t> order(degrees.size());
+            for (size_t vertex = 0; vertex < degrees.size(); ++vertex)
+            {
+                size_t degree = degrees[vertex];
+                order[starts[descending ? maxDegree - degree : degree]++] = vertex;
+            }
+            return order;
+        }
+
+        // Out-edges keep their original order under the new ids
+        TCompactGraph Relabel(const IndexGraph& forward) const
+        {
+            const auto& sourceOffsets = forward.Offsets();
+            const auto& sourceTargets = forward.Targets();
+            size_t vertexCount = order_.size();
+            std::vector<size_t> offsets(vertexCount + 1, 0);
+            for (size_t position = 0; position < vertexCount; ++position)
+            {
+                offsets[position + 1] = offsets[position] + forward.OutDegree(order_[position]);
+            }
+            std::vector<TIndex> targets(sourceTargets.size());
+            for (size_t position = 0; position < vertexCount; ++position)
+            {
+                size_t vertex = order_[position];
+                size_t target = offsets[position];
+                for (size_t edge = sourceOffsets[vertex]; edge < sourceOffsets[vertex + 1]; ++edge)
+                {
+                    targets[target++] = TIndex(newIndices_[sourceTargets[edge]]);
+                }
+            }
+            return TCompactGraph(std::move(offsets), std::move(targets));
+        }
+
+    private:
+        const TGraph& graph_;
+        VertexIndexMap<TGraph, TPropertyMapSelector> indices_;
+        std::vector<size_t> order_;
+        std::vector<size_t> newIndices_;
+        TCompactGraph compactGraph_;
+    };
+}
+
+#endif
\ No newline at end of file
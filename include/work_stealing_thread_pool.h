@@ -0,0 +1,285 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_WORK_STEALING_THREAD_POOL_H_
+#define STRONGLY_CONNECTED_COMPONENTS_WORK_STEALING_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Graph
+{
+    // Fixed set of worker threads, each owning a task deque. A worker pops
+    // its own newest task first and steals the oldest task of another worker
+    // when its deque runs dry, so recursive task trees stay cache-local
+    // while large subtrees migrate to idle threads.
+    class WorkStealingThreadPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        // threadCount == 0 picks std::thread::hardware_concurrency()
+        explicit WorkStealingThreadPool(size_t threadCount = 0)
+            : queues_()
+            , threads_()
+            , sleepMutex_()
+            , wakeUp_()
+            , pendingCount_(0)
+            , nextQueue_(0)
+            , stopping_(false)
+        {
+            if (threadCount == 0)
+            {
+                threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+            }
+            for (size_t index = 0; index < threadCount; ++index)
+            {
+                queues_.emplace_back(new WorkerQueue());
+            }
+            for (size_t index = 0; index < threadCount; ++index)
+            {
+                threads_.emplace_back([this, index]() { WorkerLoop(index); });
+            }
+        }
+
+        WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+        WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+        ~WorkStealingThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                stopping_ = true;
+            }
+            wakeUp_.notify_all();
+            for (auto& thread : threads_)
+            {
+                thread.join();
+            }
+        }
+
+        size_t ThreadCount() const
+        {
+            return threads_.size();
+        }
+
+        // Tasks submitted from a worker go to that worker's own deque
+        void Submit(Task task)
+        {
+            size_t index = CurrentWorker().pool == this ?
+                CurrentWorker().index :
+                nextQueue_.fetch_add(1) % queues_.size();
+            // Counted before it is published, so a thief never decrements
+            // past zero; a worker that sees the count early just retries
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                ++pendingCount_;
+            }
+            {
+                std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+                queues_[index]->tasks.push_back(std::move(task));
+            }
+            wakeUp_.notify_one();
+        }
+
+        // Runs one pending task on the calling thread, if any is available.
+        // Lets threads that wait for results help instead of blocking.
+        bool TryRunPendingTask()
+        {
+            size_t index = CurrentWorker().pool == this ? CurrentWorker().index : 0;
+            Task task;
+            if (!TryTakeTask(index, task))
+            {
+                return false;
+            }
+            task();
+            return true;
+        }
+
+    private:
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        struct WorkerIdentity
+        {
+            const WorkStealingThreadPool* pool;
+            size_t index;
+        };
+
+        static WorkerIdentity& CurrentWorker()
+        {
+            static thread_local WorkerIdentity identity = { nullptr, 0 };
+            return identity;
+        }
+
+        bool TryTakeTask(size_t index, Task& task)
+        {
+            {
+                auto& own = *queues_[index];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.tasks.empty())
+                {
+                    task = std::move(own.tasks.back());
+                    own.tasks.pop_back();
+                    --pendingCount_;
+                    return true;
+                }
+            }
+            for (size_t shift = 1; shift < queues_.size(); ++shift)
+            {
+                auto& victim = *queues_[(index + shift) % queues_.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty())
+                {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    --pendingCount_;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void WorkerLoop(size_t index)
+        {
+            CurrentWorker() = WorkerIdentity{ this, index };
+            while (true)
+            {
+                Task task;
+                if (TryTakeTask(index, task))
+                {
+                    task();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleepMutex_);
+                wakeUp_.wait(lock, [this]() { return stopping_ || pendingCount_ > 0; });
+                if (stopping_ && pendingCount_ == 0)
+                {
+                    return;
+                }
+            }
+        }
+
+    private:
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+        std::vector<std::thread> threads_;
+        std::mutex sleepMutex_;
+        std::condition_variable wakeUp_;
+        std::atomic<size_t> pendingCount_;
+        std::atomic<size_t> nextQueue_;
+        bool stopping_;
+    };
+
+    // Tracks a set of tasks submitted to a pool. Tasks may run further tasks
+    // in the same group; Wait() returns once all of them have finished and
+    // rethrows the first exception any of them raised.
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(WorkStealingThreadPool& pool)
+            : pool_(pool)
+            , pendingCount_(0)
+            , errorMutex_()
+            , error_()
+        {}
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        ~TaskGroup()
+        {
+            while (pendingCount_ > 0)
+            {
+                Help();
+            }
+        }
+
+        template <typename TFunc>
+        void Run(TFunc func)
+        {
+            ++pendingCount_;
+            pool_.Submit([this, func]() mutable
+            {
+                try
+                {
+                    func();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex_);
+                    if (!error_)
+                    {
+                        error_ = std::current_exception();
+                    }
+                }
+                --pendingCount_;
+            });
+        }
+
+        void Wait()
+        {
+            while (pendingCount_ > 0)
+            {
+                Help();
+            }
+            if (error_)
+            {
+                auto error = error_;
+                error_ = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+
+    private:
+        void Help()
+        {
+            if (!pool_.TryRunPendingTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        WorkStealingThreadPool& pool_;
+        std::atomic<size_t> pendingCount_;
+        std::mutex errorMutex_;
+        std::exception_ptr error_;
+    };
+
+    // Splits [begin, end) into chunks of at least grainSize indices and runs
+    // func(chunkBegin, chunkEnd) on each of them in parallel.
+    template <typename TFunc>
+    void ParallelFor(WorkStealingThreadPool& pool, size_t begin, size_t end,
+        size_t grainSize, TFunc func)
+    {
+        if (end <= begin)
+        {
+            return;
+        }
+        grainSize = std::max<size_t>(grainSize,
+            (end - begin + 4 * pool.ThreadCount() - 1) / (4 * pool.ThreadCount()));
+        if (end - begin <= grainSize)
+        {
+            func(begin, end);
+            return;
+        }
+        TaskGroup group(pool);
+        for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+        {
+            size_t chunkEnd = std::min(end, chunkBegin + grainSize);
+            group.Run([&func, chunkBegin, chunkEnd]() { func(chunkBegin, chunkEnd); });
+        }
+        group.Wait();
+    }
+}
+
+#endif
\ No newline at end of file
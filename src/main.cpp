@@ -1,6 +1,12 @@
+#include <cstring>
+#include <exception>
 #include <iostream>
+#include <string>
 
 #include "adjacency_graph.h"
+#include "binary_graph_format.h"
+#include "edge_list_reader.h"
+#include "mapped_graph.h"
 #include "strongly_connected_component_algorithm.h"
 
 
@@ -36,30 +42,81 @@ Graph::AdjacencyGraph<int, Graph::Edge<int>> ReadGraph()
     return graph;
 }
 
-void Run()
+template <typename TGraph>
+void PrintComponents(const TGraph& graph)
 {
     std::ostream& out = std::cout;
-    out << "This application detects strongly connected components of a given graph\n";
+    // Vertices are numbered 0..n-1, so results can live in flat arrays
     using AlgorithmType = Graph::StronglyConnectedComponentAlgorithm<
-        Graph::AdjacencyGraph<int, Graph::Edge<int>>>;
+        TGraph, Graph::VectorPropertyMapSelector>;
 
-    Graph::AdjacencyGraph<int, Graph::Edge<int>> graph = ReadGraph();
     AlgorithmType algo(graph);
     algo.Compute();
-    auto components = algo.GetComponents();
+    const auto& components = algo.GetComponents();
 
     for (const auto& vertex : graph.Vertices())
     {
         out << "Vertex " << vertex << " belongs to component # "
-            << (*components)[vertex] << '\n';
+            << components[vertex] << '\n';
     }
 }
 
+void Run()
+{
+    std::ostream& out = std::cout;
+    out << "This application detects strongly connected components of a given graph\n";
+    PrintComponents(ReadGraph());
+}
 
-int main()
+// Reads a graph interactively and stores it in the binary format
+void Save(const std::string& path)
 {
-    Run();
-    return 0;
+    Graph::WriteBinaryGraph(ReadGraph(), path);
+    std::cout << "Graph saved to " << path << '\n';
 }
 
+// Maps a graph stored in the binary format; nothing is parsed or copied.
+// The file comes from outside, so its arrays are checked before traversal.
+void RunMapped(const std::string& path)
+{
+    Graph::MappedGraph<int, Graph::Edge<int>> graph(path);
+    graph.Validate();
+    PrintComponents(graph);
+}
+
+// Loads a text edge list ("source target" per line) in parallel
+void RunEdgeList(const std::string& path)
+{
+    PrintComponents(Graph::ReadEdgeList<int>(path));
+}
+
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (argc == 3 && std::strcmp(argv[1], "--save") == 0)
+        {
+            Save(argv[2]);
+        }
+        else if (argc == 3 && std::strcmp(argv[1], "--edges") == 0)
+        {
+            RunEdgeList(argv[2]);
+        }
+        else if (argc == 2)
+        {
+            RunMapped(argv[1]);
+        }
+        else
+        {
+            Run();
+        }
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
 
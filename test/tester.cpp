@@ -1,9 +1,38 @@
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "adjacency_graph.h"
+#include "batch_strongly_connected_components.h"
+#include "algorithm_statistics.h"
+#include "bidirectional_graph.h"
+#include "compressed_sparse_row_graph.h"
+#include "condensation.h"
+#include "delta_compressed_graph.h"
+#include "binary_graph_format.h"
+#include "mapped_graph.h"
+#include "depth_first_search_algorithm.h"
+#include "edge_list_reader.h"
+#include "forward_backward_strongly_connected_component_algorithm.h"
+#include "graph_generators.h"
+#include "dynamic_strongly_connected_components.h"
+#include "pearce_strongly_connected_component_algorithm.h"
+#include "reversed_graph.h"
+#include "semi_external_strongly_connected_component_algorithm.h"
+#include "trim_algorithm.h"
+#include "vertex_reordering.h"
 #include "strongly_connected_component_algorithm.h"
 
 
@@ -27,22 +56,75 @@ ValueType GetRandomValue(const ValueType& min, const ValueType& max)
 }
 
 template <typename ValueType>
-Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>> GetRandomGraph()
+Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>> GetRandomGraph(uint64_t seed)
 {
-    Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>> graph;
     size_t vertexCount = GetRandomValue<size_t>(1, 100);
-    for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+    size_t edgesCount = GetRandomValue<size_t>(0, vertexCount * (vertexCount - 1) / 2);
+    auto generated = Graph::GraphGenerator<ValueType>(seed).ErdosRenyi(
+        vertexCount, edgesCount);
+    Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>> graph;
+    graph.AddVerticesAndEdgeRange(generated.edges.begin(), generated.edges.end());
+    return graph;
+}
+
+// Scratch files live in TMPDIR, not in the working directory
+std::string GetTemporaryPath(const std::string& name)
+{
+    const char* directory = std::getenv("TMPDIR");
+    return std::string(directory != nullptr ? directory : "/tmp") + "/" + name;
+}
+
+// Generators must not depend on the thread count, and planted components
+// must come back exactly, at a size well beyond the random graphs
+bool TestGenerators(std::ostream& out)
+{
+    try
     {
-        size_t edgesCount = GetRandomValue<size_t>(0, vertexCount - 1);
-        while (edgesCount > 0)
+        Graph::GraphGenerator<uint32_t> serial(7, 1);
+        Graph::GraphGenerator<uint32_t> parallel(7, 4);
+        auto serialGraph = serial.Rmat(12, 200000);
+        auto parallelGraph = parallel.Rmat(12, 200000);
+        for (size_t index = 0; index < serialGraph.edges.size(); ++index)
+        {
+            if (serialGraph.edges[index].Source() != parallelGraph.edges[index].Source() ||
+                serialGraph.edges[index].Target() != parallelGraph.edges[index].Target())
+            {
+                throw std::logic_error("generated edges depend on the thread count");
+            }
+        }
+
+        auto planted = parallel.PlantedComponents(2000, 50, 100000, 50000)
+            .ToCompressedSparseRowGraph();
+        Graph::StronglyConnectedComponentAlgorithm<decltype(planted)> algo(planted);
+        algo.Compute();
+        const auto& components = algo.GetComponents();
+        for (uint32_t vertex = 0; vertex < planted.VertexCount(); ++vertex)
+        {
+            if (components[vertex] != components[vertex / 50 * 50])
+            {
+                throw std::logic_error("planted component was split");
+            }
+        }
+        if (algo.GetComponentsCount() != 2000)
         {
-            size_t destination = GetRandomValue<size_t>(0, vertexCount - 1);
-            graph.AddVerticesAndEdge(
-                Graph::Edge<ValueType>(ValueType(vertex), ValueType(destination)));
-            --edgesCount;
+            throw std::logic_error("planted components were merged");
+        }
+
+        auto dag = parallel.LayeredDag(100, 100, 50000).ToCompressedSparseRowGraph();
+        Graph::PearceStronglyConnectedComponentAlgorithm<decltype(dag)> dagAlgo(dag);
+        dagAlgo.Compute();
+        if (dagAlgo.GetComponentsCount() != dag.VertexCount())
+        {
+            throw std::logic_error("layered DAG has a cycle");
         }
     }
-    return graph;
+    catch (const std::exception& exc)
+    {
+        out << "Test failed. Reason: " << exc.what() << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
 }
 
 template <typename ValueType>
@@ -64,6 +146,647 @@ void PrintGraph(
     }
 }
 
+template <typename TGraph, typename TComponents, typename TOtherComponents>
+bool HaveSameComponents(const TGraph& graph,
+    const TComponents& components, const TOtherComponents& otherComponents)
+{
+    std::unordered_map<size_t, size_t> forward;
+    std::unordered_map<size_t, size_t> backward;
+    for (const auto& vertex : graph.Vertices())
+    {
+        size_t component = components[vertex];
+        size_t otherComponent = otherComponents[vertex];
+        if (forward.emplace(component, otherComponent).first->second != otherComponent ||
+            backward.emplace(otherComponent, component).first->second != component)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks maintained components and their topological order against a
+// from-scratch computation on the current graph
+template <typename TGraph, typename TDynamic>
+void CheckDynamicComponents(const TGraph& graph, const TDynamic& dynamic)
+{
+    Graph::StronglyConnectedComponentAlgorithm<TGraph> algo(graph);
+    algo.Compute();
+    const auto& components = algo.GetComponents();
+    if (algo.GetComponentsCount() != dynamic.GetComponentsCount())
+    {
+        throw std::logic_error("dynamic component count differs");
+    }
+
+    std::unordered_map<size_t, size_t> forward;
+    std::unordered_map<size_t, size_t> backward;
+    for (const auto& vertex : graph.Vertices())
+    {
+        size_t component = components[vertex];
+        size_t otherComponent = dynamic.GetComponent(vertex);
+        if (forward.emplace(component, otherComponent).first->second != otherComponent ||
+            backward.emplace(otherComponent, component).first->second != component)
+        {
+            throw std::logic_error("dynamic components differ");
+        }
+    }
+
+    std::unordered_map<size_t, size_t> positions;
+    for (auto component : dynamic.GetTopologicalOrder())
+    {
+        positions.emplace(component, positions.size());
+    }
+    for (const auto& vertex : graph.Vertices())
+    {
+        for (const auto& edge : graph.OutEdges(vertex))
+        {
+            if (positions.at(dynamic.GetComponent(edge.Source())) >
+                positions.at(dynamic.GetComponent(edge.Target())))
+            {
+                throw std::logic_error("dynamic topological order is violated");
+            }
+        }
+    }
+}
+
+// Replays the edges of graph one by one, then removes every other edge and
+// a few vertices, checking the maintained components after each phase
+template <typename ValueType>
+void TestDynamicComponents(
+    const Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>& graph)
+{
+    using TGraph = Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>;
+    TGraph changingGraph;
+    Graph::DynamicStronglyConnectedComponents<TGraph> dynamic(changingGraph);
+    for (const auto& edge : graph.GetEdges())
+    {
+        changingGraph.AddVerticesAndEdge(edge);
+    }
+    CheckDynamicComponents(changingGraph, dynamic);
+
+    bool remove = false;
+    for (const auto& edge : graph.GetEdges())
+    {
+        if ((remove = !remove))
+        {
+            changingGraph.RemoveEdge(edge);
+        }
+    }
+    CheckDynamicComponents(changingGraph, dynamic);
+
+    changingGraph.RemoveVertexIf([](const ValueType& vertex) { return vertex % 5 == 0; });
+    CheckDynamicComponents(changingGraph, dynamic);
+    for (const auto& vertex : graph.Vertices())
+    {
+        if (vertex % 5 == 0 && dynamic.GetComponent(vertex) != dynamic.kNoComponent)
+        {
+            throw std::logic_error("removed vertex still has a dynamic component");
+        }
+    }
+
+    // Assignment replaces the whole edge set under the observer
+    changingGraph = graph;
+    CheckDynamicComponents(changingGraph, dynamic);
+    TGraph reversed;
+    for (const auto& edge : graph.GetEdges())
+    {
+        reversed.AddVerticesAndEdge(Graph::Edge<ValueType>(edge.Target(), edge.Source()));
+    }
+    changingGraph = std::move(reversed);
+    CheckDynamicComponents(changingGraph, dynamic);
+
+    // A graph moved out from under an observer must not call back into it,
+    // also after the observer is gone
+    size_t notifications = 0;
+    TGraph moved = [&changingGraph, &notifications]()
+    {
+        TGraph observed(changingGraph);
+        Graph::DynamicStronglyConnectedComponents<TGraph> observer(observed);
+        observed.SetEdgeAddedAction(
+            [&notifications](const Graph::Edge<ValueType>&) { ++notifications; });
+        return TGraph(std::move(observed));
+    }();
+    for (const auto& edge : graph.GetEdges())
+    {
+        moved.RemoveEdge(edge);
+        moved.AddVerticesAndEdge(Graph::Edge<ValueType>(edge.Target(), edge.Source()));
+    }
+    Graph::DynamicStronglyConnectedComponents<TGraph> movedDynamic(moved);
+    moved.AddVerticesAndEdge(Graph::Edge<ValueType>(0, 1));
+    CheckDynamicComponents(moved, movedDynamic);
+    if (notifications != 0)
+    {
+        throw std::logic_error("moved graph kept notifying the old observer");
+    }
+}
+
+// Mutates an indexed copy and a plain copy of graph side by side and
+// compares their membership answers
+template <typename ValueType>
+void TestMembershipIndex(
+    const Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>& graph)
+{
+    auto indexed = graph;
+    auto plain = graph;
+    indexed.SetMembershipIndexThreshold(2);
+    plain.SetMembershipIndexThreshold(plain.kNoMembershipIndex);
+
+    ValueType bound = ValueType(Graph::VertexIndexBound(graph));
+    for (int step = 0; step < 1000; ++step)
+    {
+        Graph::Edge<ValueType> edge(GetRandomValue<ValueType>(0, bound),
+            GetRandomValue<ValueType>(0, bound));
+        int action = GetRandomValue<int>(0, 9);
+        bool changedIndexed = false;
+        bool changedPlain = false;
+        if (action < 4)
+        {
+            changedIndexed = indexed.AddVerticesAndEdge(edge);
+            changedPlain = plain.AddVerticesAndEdge(edge);
+        }
+        else if (action < 8)
+        {
+            changedIndexed = indexed.RemoveEdge(edge);
+            changedPlain = plain.RemoveEdge(edge);
+        }
+        else if (action < 9)
+        {
+            auto pred = [&edge](const Graph::Edge<ValueType>& other)
+            {
+                return other.Target() == edge.Target();
+            };
+            changedIndexed = indexed.RemoveEdgeIf(pred) > 0;
+            changedPlain = plain.RemoveEdgeIf(pred) > 0;
+        }
+        else
+        {
+            changedIndexed = indexed.RemoveVertex(edge.Source());
+            changedPlain = plain.RemoveVertex(edge.Source());
+        }
+        if (changedIndexed != changedPlain ||
+            indexed.ContainsEdge(edge) != plain.ContainsEdge(edge) ||
+            indexed.EdgeCount() != plain.EdgeCount())
+        {
+            throw std::logic_error("membership index disagrees with the edge lists");
+        }
+    }
+}
+
+// Workspaces outlive the algorithms and are shared by every generated
+// graph, so each run starts from storage sized for another graph
+template <typename ValueType, typename TComponentMap>
+void TestWorkspace(const Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>& graph,
+    const TComponentMap& components, size_t componentsCount)
+{
+    using TGraph = Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>;
+    using StampedAlgorithm = Graph::StronglyConnectedComponentAlgorithm<TGraph,
+        Graph::StampedPropertyMapSelector>;
+    using HashAlgorithm = Graph::StronglyConnectedComponentAlgorithm<TGraph>;
+    static typename StampedAlgorithm::TWorkspace stampedWorkspace;
+    static typename HashAlgorithm::TWorkspace hashWorkspace;
+
+    TGraph cycle;
+    cycle.AddVerticesAndEdge(Graph::Edge<ValueType>(0, 1));
+    cycle.AddVerticesAndEdge(Graph::Edge<ValueType>(1, 0));
+    for (int round = 0; round < 2; ++round)
+    {
+        StampedAlgorithm stamped(graph, stampedWorkspace);
+        stamped.Compute();
+        HashAlgorithm hashed(graph, hashWorkspace);
+        hashed.Compute();
+        if (stamped.GetComponentsCount() != componentsCount ||
+            hashed.GetComponentsCount() != componentsCount ||
+            !HaveSameComponents(graph, components, stamped.GetComponents()) ||
+            !HaveSameComponents(graph, components, hashed.GetComponents()))
+        {
+            throw std::logic_error("reused workspace changed the components");
+        }
+
+        StampedAlgorithm small(cycle, stampedWorkspace);
+        small.Compute();
+        if (small.GetComponentsCount() != 1 ||
+            small.GetComponents()[0] != small.GetComponents()[1])
+        {
+            throw std::logic_error("workspace kept state from a larger graph");
+        }
+    }
+
+    size_t discovered = 0;
+    Graph::DepthFirstSearchAlgorithm<TGraph, Graph::StampedPropertyMapSelector> dfs(
+        graph, stampedWorkspace.Search());
+    dfs.SetDiscoverVertexAction([&discovered](const ValueType&) { ++discovered; });
+    dfs.Compute();
+    if (discovered != graph.VertexCount())
+    {
+        throw std::logic_error("search with a reused workspace missed vertices");
+    }
+}
+
+// The flat layout must behave exactly like the node layout
+template <typename ValueType, typename TComponentMap>
+void TestFlatContainers(const Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>& graph,
+    const TComponentMap& components)
+{
+    using FlatGraph = Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>,
+        Graph::FlatContainerPolicy>;
+
+    FlatGraph flat;
+    auto edges = graph.GetEdges();
+    flat.AddVertexRange(graph.Vertices().begin(), graph.Vertices().end());
+    flat.AddEdgeRange(edges.begin(), edges.end());
+    flat.AddEdgeRange(edges.begin(), edges.end());
+    if (flat.VertexCount() != graph.VertexCount() || flat.EdgeCount() != graph.EdgeCount())
+    {
+        throw std::logic_error("flat graph lost vertices or kept duplicate edges");
+    }
+
+    Graph::StronglyConnectedComponentAlgorithm<FlatGraph> tarjan(flat);
+    tarjan.Compute();
+    Graph::PearceStronglyConnectedComponentAlgorithm<FlatGraph> pearce(flat);
+    pearce.Compute();
+    if (!HaveSameComponents(graph, components, tarjan.GetComponents()) ||
+        !HaveSameComponents(graph, components, pearce.GetComponents()))
+    {
+        throw std::logic_error("components differ on the flat graph");
+    }
+
+    auto plain = graph;
+    ValueType bound = ValueType(Graph::VertexIndexBound(graph));
+    for (int step = 0; step < 1000; ++step)
+    {
+        Graph::Edge<ValueType> edge(GetRandomValue<ValueType>(0, bound),
+            GetRandomValue<ValueType>(0, bound));
+        int action = GetRandomValue<int>(0, 9);
+        bool changedFlat = false;
+        bool changedPlain = false;
+        if (action < 5)
+        {
+            changedFlat = flat.AddVerticesAndEdge(edge);
+            changedPlain = plain.AddVerticesAndEdge(edge);
+        }
+        else if (action < 9)
+        {
+            changedFlat = flat.RemoveEdge(edge);
+            changedPlain = plain.RemoveEdge(edge);
+        }
+        else
+        {
+            changedFlat = flat.RemoveVertex(edge.Source());
+            changedPlain = plain.RemoveVertex(edge.Source());
+        }
+        if (changedFlat != changedPlain ||
+            flat.ContainsEdge(edge) != plain.ContainsEdge(edge) ||
+            flat.VertexCount() != plain.VertexCount() ||
+            flat.EdgeCount() != plain.EdgeCount())
+        {
+            throw std::logic_error("flat graph disagrees with the node graph");
+        }
+    }
+
+    size_t removedVertices = 0;
+    flat.SetVertexRemovedAction([&removedVertices](const ValueType&) { ++removedVertices; });
+    size_t vertexCount = flat.VertexCount();
+    flat.Clear();
+    if (removedVertices != vertexCount || flat.VertexCount() != 0)
+    {
+        throw std::logic_error("clearing the flat graph went wrong");
+    }
+}
+
+// Builds a copy whose nodes and result maps live in a NodePool
+template <typename ValueType, typename TComponentMap>
+void TestNodePool(const Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>& graph,
+    const TComponentMap& components)
+{
+    using PooledGraph = Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>,
+        Graph::PoolContainerPolicy>;
+
+    Graph::NodePool pool;
+    Graph::NodePool::Scope scope(pool);
+    PooledGraph pooled;
+    auto edges = graph.GetEdges();
+    pooled.AddVertexRange(graph.Vertices().begin(), graph.Vertices().end());
+    pooled.AddEdgeRange(edges.begin(), edges.end());
+    if (pooled.EdgeCount() != graph.EdgeCount() ||
+        (graph.VertexCount() > 0 && pool.ReservedBytes() == 0))
+    {
+        throw std::logic_error("pooled graph lost edges or bypassed the pool");
+    }
+
+    // Removed nodes are recycled through the free lists
+    size_t reserved = pool.ReservedBytes();
+    size_t removed = pooled.RemoveEdgeIf(
+        [](const Graph::Edge<ValueType>& edge) { return edge.Source() < edge.Target(); });
+    if (pooled.AddEdgeRange(edges.begin(), edges.end()) != removed ||
+        pool.ReservedBytes() != reserved)
+    {
+        throw std::logic_error("pool did not reuse freed nodes");
+    }
+
+    PooledGraph copy(pooled);
+    Graph::StronglyConnectedComponentAlgorithm<PooledGraph> algo(copy);
+    algo.Compute();
+    if (!HaveSameComponents(graph, components, algo.GetComponents()))
+    {
+        throw std::logic_error("components differ on the pooled graph");
+    }
+    pooled.Clear();
+    if (pooled.VertexCount() != 0 || pooled.EdgeCount() != 0 ||
+        copy.EdgeCount() != graph.EdgeCount())
+    {
+        throw std::logic_error("clearing the pooled graph went wrong");
+    }
+}
+
+// Checks in-edge bookkeeping, components of the reversed view, and that
+// vertex removal matches AdjacencyGraph
+template <typename ValueType, typename TComponentMap>
+void TestBidirectionalGraph(
+    const Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>& graph,
+    const TComponentMap& components)
+{
+    using TGraph = Graph::BidirectionalGraph<ValueType, Graph::Edge<ValueType>>;
+    TGraph bidirectional;
+    for (const auto& vertex : graph.Vertices())
+    {
+        bidirectional.AddVertex(vertex);
+    }
+    auto edges = graph.GetEdges();
+    bidirectional.AddEdgeRange(edges.begin(), edges.end());
+
+    size_t inEdgeCount = 0;
+    for (const auto& vertex : bidirectional.Vertices())
+    {
+        for (const auto& edge : bidirectional.InEdges(vertex))
+        {
+            if (edge.Target() != vertex || !graph.ContainsEdge(edge))
+            {
+                throw std::logic_error("bidirectional graph has a wrong in-edge");
+            }
+            ++inEdgeCount;
+        }
+    }
+    if (inEdgeCount != graph.EdgeCount() || bidirectional.EdgeCount() != graph.EdgeCount())
+    {
+        throw std::logic_error("bidirectional graph lost edges");
+    }
+
+    auto reversed = Graph::MakeReversedGraph(bidirectional);
+    Graph::StronglyConnectedComponentAlgorithm<decltype(reversed)> reversedAlgo(reversed);
+    reversedAlgo.Compute();
+    if (!HaveSameComponents(graph, components, reversedAlgo.GetComponents()))
+    {
+        throw std::logic_error("reversing the edges changed the components");
+    }
+
+    auto pruned = graph;
+    auto isPruned = [](const ValueType& vertex) { return vertex % 3 == 0; };
+    pruned.RemoveVertexIf(isPruned);
+    bidirectional.RemoveVertexIf(isPruned);
+    if (bidirectional.VertexCount() != pruned.VertexCount() ||
+        bidirectional.EdgeCount() != pruned.EdgeCount())
+    {
+        throw std::logic_error("bidirectional vertex removal differs");
+    }
+    for (const auto& edge : pruned.GetEdges())
+    {
+        if (!bidirectional.ContainsEdge(edge))
+        {
+            throw std::logic_error("bidirectional vertex removal dropped an edge");
+        }
+    }
+}
+
+// Checks members, de-duplicated edges and topological order of the
+// condensation built from a component numbering
+template <typename TGraph, typename TComponentMap>
+void TestCondensation(const TGraph& graph, const TComponentMap& components,
+    size_t componentsCount)
+{
+    auto condensation = Graph::MakeCondensation(graph, components, componentsCount);
+    const auto& dag = condensation.GetComponentGraph();
+
+    size_t memberCount = 0;
+    for (size_t component = 0; component < componentsCount; ++component)
+    {
+        for (const auto& member : condensation.GetMembers(component))
+        {
+            if (components[member] != component)
+            {
+                throw std::logic_error("condensation put a vertex in the wrong component");
+            }
+        }
+        memberCount += condensation.GetComponentSize(component);
+    }
+
+    std::set<std::pair<size_t, size_t>> componentEdges;
+    for (const auto& vertex : graph.Vertices())
+    {
+        for (const auto& edge : graph.OutEdges(vertex))
+        {
+            if (components[edge.Source()] != components[edge.Target()])
+            {
+                componentEdges.emplace(components[edge.Source()], components[edge.Target()]);
+            }
+        }
+    }
+    if (memberCount != graph.VertexCount() || dag.EdgeCount() != componentEdges.size())
+    {
+        throw std::logic_error("condensation lost vertices or kept duplicate edges");
+    }
+
+    std::vector<size_t> positions(componentsCount, componentsCount);
+    const auto& order = condensation.GetTopologicalOrder();
+    for (size_t position = 0; position < order.size(); ++position)
+    {
+        positions[order[position]] = position;
+    }
+    for (const auto& componentEdge : componentEdges)
+    {
+        if (!dag.ContainsEdge(componentEdge.first, componentEdge.second) ||
+            positions[componentEdge.first] >= positions[componentEdge.second])
+        {
+            throw std::logic_error("condensation order is not topological");
+        }
+    }
+}
+
+template <typename ValueType, typename TComponentMap>
+void TestStatistics(const Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>& graph,
+    const TComponentMap& components)
+{
+    using TGraph = Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>;
+    using TSelector = typename Graph::DefaultPropertyMapSelector<TGraph>::type;
+
+    Graph::DepthFirstSearchAlgorithm<TGraph, TSelector,
+        Graph::DepthFirstSearchActionVisitor<ValueType, Graph::Edge<ValueType>>,
+        Graph::CollectStatistics> dfs(graph);
+    dfs.Compute();
+    const auto& dfsStatistics = dfs.GetStatistics().Get();
+    if (dfsStatistics.discoveredVertices != graph.VertexCount() ||
+        dfsStatistics.examinedEdges != graph.EdgeCount() ||
+        dfsStatistics.treeEdges + dfsStatistics.backEdges +
+        dfsStatistics.forwardOrCrossEdges != dfsStatistics.examinedEdges ||
+        dfsStatistics.maxStackDepth > graph.VertexCount() ||
+        (graph.VertexCount() > 0 && dfsStatistics.maxStackDepth == 0) ||
+        dfsStatistics.peakResultBytes == 0)
+    {
+        throw std::logic_error("depth first search statistics are inconsistent");
+    }
+
+    Graph::StronglyConnectedComponentAlgorithm<TGraph, TSelector,
+        Graph::CollectStatistics> tarjan(graph);
+    tarjan.Compute();
+    const auto& tarjanStatistics = tarjan.GetStatistics().Get();
+    if (!HaveSameComponents(graph, components, tarjan.GetComponents()) ||
+        tarjanStatistics.examinedEdges != graph.EdgeCount() ||
+        tarjanStatistics.maxStackDepth != dfsStatistics.maxStackDepth ||
+        tarjanStatistics.peakResultBytes < dfsStatistics.peakResultBytes)
+    {
+        throw std::logic_error("component search statistics are inconsistent");
+    }
+
+    Graph::PearceStronglyConnectedComponentAlgorithm<TGraph, TSelector,
+        Graph::CollectStatistics> pearce(graph);
+    pearce.Compute();
+    const auto& pearceStatistics = pearce.GetStatistics().Get();
+    if (pearceStatistics.discoveredVertices != graph.VertexCount() ||
+        pearceStatistics.examinedEdges != graph.EdgeCount() ||
+        pearceStatistics.treeEdges != dfsStatistics.treeEdges ||
+        pearceStatistics.maxStackDepth != dfsStatistics.maxStackDepth)
+    {
+        throw std::logic_error("Pearce's algorithm statistics are inconsistent");
+    }
+
+    // Hardware counters may be unavailable here; the counts must not change
+    Graph::PearceStronglyConnectedComponentAlgorithm<TGraph, TSelector,
+        Graph::CollectPerformanceStatistics> counted(graph);
+    counted.Compute();
+    const auto& countedStatistics = counted.GetStatistics();
+    if (countedStatistics.Get().examinedEdges != pearceStatistics.examinedEdges)
+    {
+        throw std::logic_error("performance counters changed the statistics");
+    }
+    const auto& computeCounts = countedStatistics.GetPhaseCounts(Graph::COMPUTE);
+    for (int event = 0; event < Graph::PERFORMANCE_EVENT_COUNT; ++event)
+    {
+        if (!computeCounts.available[event] && computeCounts.values[event] != 0)
+        {
+            throw std::logic_error("unavailable performance counter reported a value");
+        }
+    }
+}
+
+// Every order must be a permutation that keeps the edges, and components
+// found on the relabeled graph must map back to the original ones
+template <typename ValueType, typename TComponentMap>
+void TestReordering(const Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>& graph,
+    const TComponentMap& components)
+{
+    using TGraph = Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>;
+
+    for (int index = 0; index < Graph::VERTEX_ORDER_COUNT; ++index)
+    {
+        auto order = static_cast<Graph::VertexOrder>(index);
+        Graph::VertexReordering<TGraph, uint32_t> reordering(graph, order);
+        const auto& compact = reordering.GetGraph();
+        if (compact.VertexCount() != graph.VertexCount() ||
+            compact.EdgeCount() != graph.EdgeCount())
+        {
+            throw std::logic_error(std::string("reordering lost vertices or edges: ") +
+                Graph::VertexOrderName(order));
+        }
+        for (const auto& vertex : graph.Vertices())
+        {
+            uint32_t newIndex = reordering.NewIndexOf(vertex);
+            if (reordering.OriginalVertexAt(newIndex) != vertex ||
+                compact.OutDegree(newIndex) != graph.OutDegree(vertex))
+            {
+                throw std::logic_error(std::string("reordering is not a permutation: ") +
+                    Graph::VertexOrderName(order));
+            }
+            for (const auto& edge : graph.OutEdges(vertex))
+            {
+                if (!compact.ContainsEdge(newIndex, reordering.NewIndexOf(edge.Target())))
+                {
+                    throw std::logic_error(std::string("reordering dropped an edge: ") +
+                        Graph::VertexOrderName(order));
+                }
+            }
+        }
+
+        using TCompactGraph = typename Graph::VertexReordering<TGraph, uint32_t>::TCompactGraph;
+        Graph::StronglyConnectedComponentAlgorithm<TCompactGraph> algo(compact);
+        algo.Compute();
+        auto mapped = reordering.template MapBack<size_t>(algo.GetComponents());
+        if (!HaveSameComponents(graph, components, mapped))
+        {
+            throw std::logic_error(std::string("reordered components do not map back: ") +
+                Graph::VertexOrderName(order));
+        }
+    }
+}
+
+// Decoded lists must hold the same edges, sorted, and the searches must
+// find the same components on the compressed graph
+template <typename ValueType, typename TComponentMap>
+void TestDeltaCompressedGraph(
+    const Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>& graph,
+    const TComponentMap& components)
+{
+    auto compressed = Graph::MakeDeltaCompressedGraph(graph);
+    if (compressed.EdgeCount() != graph.EdgeCount())
+    {
+        throw std::logic_error("compressed graph lost edges");
+    }
+    for (const auto& vertex : graph.Vertices())
+    {
+        if (compressed.OutDegree(vertex) != graph.OutDegree(vertex))
+        {
+            throw std::logic_error("compressed graph has a wrong out-degree");
+        }
+        for (const auto& edge : graph.OutEdges(vertex))
+        {
+            if (!compressed.ContainsEdge(edge))
+            {
+                throw std::logic_error("compressed graph dropped an edge");
+            }
+        }
+        if (!std::is_sorted(compressed.OutEdges(vertex).begin(), compressed.OutEdges(vertex).end(),
+            [](const Graph::Edge<ValueType>& left, const Graph::Edge<ValueType>& right)
+            {
+                return left.Target() < right.Target();
+            }))
+        {
+            throw std::logic_error("compressed out-edges are not sorted");
+        }
+    }
+    Graph::StronglyConnectedComponentAlgorithm<decltype(compressed)> algo(compressed);
+    algo.Compute();
+    if (!HaveSameComponents(graph, components, algo.GetComponents()))
+    {
+        throw std::logic_error("components differ on the compressed graph");
+    }
+
+    // Gaps of several varint bytes in both directions, and parallel edges
+    using TWideGraph = Graph::CompressedSparseRowGraph<uint32_t, Graph::Edge<uint32_t>>;
+    std::vector<Graph::Edge<uint32_t>> wideEdges = { { 5, 4000000 }, { 5, 3 },
+        { 5, 4000000 }, { 4000000, 0 }, { 4000000, 300 }, { 300, 299 } };
+    TWideGraph wide(4000001, wideEdges.begin(), wideEdges.end());
+    Graph::DeltaCompressedGraph<uint32_t, Graph::Edge<uint32_t>> wideCompressed(wide);
+    std::vector<uint32_t> targets;
+    for (const auto& edge : wideCompressed.OutEdges(5))
+    {
+        targets.push_back(edge.Target());
+    }
+    if (targets != std::vector<uint32_t>{ 3, 4000000, 4000000 } ||
+        !wideCompressed.ContainsEdge(4000000, 0) || !wideCompressed.ContainsEdge(4000000, 300) ||
+        wideCompressed.ContainsEdge(4000000, 299) || wideCompressed.OutDegree(300) != 1)
+    {
+        throw std::logic_error("compressed graph decoded wide gaps wrongly");
+    }
+}
+
 template <typename ValueType>
 bool RunTest(
     std::ostream& out, const Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>& graph)
@@ -75,7 +798,146 @@ bool RunTest(
     {
         Algorithm algo(graph);
         algo.Compute();
-        auto components = algo.GetComponents();
+        const auto& components = algo.GetComponents();
+
+        auto compressedGraph = Graph::MakeCompressedSparseRowGraph(graph);
+        using CompressedAlgorithm = Graph::StronglyConnectedComponentAlgorithm<
+            decltype(compressedGraph)>;
+        CompressedAlgorithm compressedAlgo(compressedGraph);
+        compressedAlgo.Compute();
+        if (!HaveSameComponents(graph, components, compressedAlgo.GetComponents()))
+        {
+            throw std::logic_error("components differ on compressed sparse row graph");
+        }
+
+        std::string mappedPath = GetTemporaryPath("scc_tester_graph.bin");
+        Graph::WriteBinaryGraph(graph, mappedPath);
+        {
+            Graph::MappedGraph<ValueType, Graph::Edge<ValueType>> mappedGraph(mappedPath);
+            Graph::StronglyConnectedComponentAlgorithm<decltype(mappedGraph)> mappedAlgo(
+                mappedGraph);
+            mappedAlgo.Compute();
+            if (mappedGraph.EdgeCount() != compressedGraph.EdgeCount() ||
+                !HaveSameComponents(graph, components, mappedAlgo.GetComponents()))
+            {
+                throw std::logic_error("components differ on memory-mapped graph");
+            }
+        }
+        std::remove(mappedPath.c_str());
+
+        // Self-loops keep every vertex in the text without changing components
+        std::ostringstream edgeList;
+        edgeList << "# random graph\n";
+        for (const auto& edge : graph.GetEdges())
+        {
+            edgeList << edge.Source() << '\t' << edge.Target() << "  # edge\r\n";
+        }
+        for (const auto& vertex : graph.Vertices())
+        {
+            edgeList << "\n" << vertex << ' ' << vertex;
+        }
+        std::string text = edgeList.str();
+        auto parsedGraph = Graph::EdgeListReader<ValueType>(4, 16).Parse(
+            text.data(), text.data() + text.size());
+        Graph::StronglyConnectedComponentAlgorithm<decltype(parsedGraph)> parsedAlgo(
+            parsedGraph);
+        parsedAlgo.Compute();
+        if (parsedGraph.EdgeCount() != compressedGraph.EdgeCount() + graph.VertexCount() ||
+            !HaveSameComponents(graph, components, parsedAlgo.GetComponents()))
+        {
+            throw std::logic_error("components differ on parsed edge list");
+        }
+
+        Graph::PearceStronglyConnectedComponentAlgorithm<
+            Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>> pearceAlgo(graph);
+        pearceAlgo.Compute();
+        if (pearceAlgo.GetComponentsCount() != algo.GetComponentsCount())
+        {
+            throw std::logic_error("Pearce's algorithm found a different component count");
+        }
+        for (const auto& vertex : graph.Vertices())
+        {
+            if (pearceAlgo.GetComponents()[vertex] != components[vertex])
+            {
+                throw std::logic_error("Pearce's algorithm numbered components differently");
+            }
+        }
+
+        Graph::ForwardBackwardStronglyConnectedComponentAlgorithm<
+            Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>> parallelAlgo(graph, 4);
+        parallelAlgo.Compute();
+        if (parallelAlgo.GetComponentsCount() != algo.GetComponentsCount() ||
+            !HaveSameComponents(graph, components, parallelAlgo.GetComponents()))
+        {
+            throw std::logic_error("forward-backward decomposition found different components");
+        }
+
+        TestCondensation(graph, components, algo.GetComponentsCount());
+        TestCondensation(graph, parallelAlgo.GetComponents(), parallelAlgo.GetComponentsCount());
+
+        Algorithm trimmedAlgo(graph);
+        trimmedAlgo.SetTrimming(true, 2);
+        trimmedAlgo.Compute();
+        if (trimmedAlgo.GetComponentsCount() != algo.GetComponentsCount() ||
+            !HaveSameComponents(graph, components, trimmedAlgo.GetComponents()))
+        {
+            throw std::logic_error("trimming changed the components");
+        }
+
+        TestDynamicComponents(graph);
+        TestStatistics(graph, components);
+        TestReordering(graph, components);
+        TestDeltaCompressedGraph(graph, components);
+
+        TestMembershipIndex(graph);
+        TestNodePool(graph, components);
+        TestFlatContainers(graph, components);
+        TestWorkspace(graph, components, algo.GetComponentsCount());
+        TestBidirectionalGraph(graph, components);
+
+        // Every edge twice, half of them already present
+        auto edges = graph.GetEdges();
+        Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>> bulkGraph;
+        bool seed = false;
+        for (const auto& edge : edges)
+        {
+            if ((seed = !seed))
+            {
+                bulkGraph.AddVerticesAndEdge(edge);
+            }
+        }
+        size_t seededCount = bulkGraph.EdgeCount();
+        edges.insert(edges.end(), edges.begin(), edges.end());
+        size_t addedCount = bulkGraph.AddVerticesAndEdgeRange(edges.begin(), edges.end());
+        if (addedCount != graph.EdgeCount() - seededCount ||
+            bulkGraph.EdgeCount() != graph.EdgeCount() ||
+            bulkGraph.VertexCount() != graph.VertexCount())
+        {
+            throw std::logic_error("bulk insertion kept duplicates or lost edges");
+        }
+
+        size_t discovered = 0;
+        size_t examined = 0;
+        Graph::DepthFirstSearchAlgorithm<
+            Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>> dfs(graph);
+        dfs.SetDiscoverVertexAction([&discovered](const ValueType&) { ++discovered; });
+        dfs.SetExamineEdgeAction(
+            [&examined](const Graph::Edge<ValueType>&) { ++examined; });
+        dfs.Compute();
+        if (discovered != graph.VertexCount() || examined != graph.EdgeCount())
+        {
+            throw std::logic_error("depth first search missed vertices or edges");
+        }
+
+        using VectorAlgorithm = Graph::StronglyConnectedComponentAlgorithm<
+            Graph::AdjacencyGraph<ValueType, Graph::Edge<ValueType>>,
+            Graph::VectorPropertyMapSelector>;
+        VectorAlgorithm vectorAlgo(graph);
+        vectorAlgo.Compute();
+        if (!HaveSameComponents(graph, components, vectorAlgo.GetComponents()))
+        {
+            throw std::logic_error("components differ with vector property maps");
+        }
     }
     catch (const std::exception& exc)
     {
@@ -88,15 +950,614 @@ bool RunTest(
     return true;
 }
 
+// Random graphs stay below the size where forward-backward pivots; these
+// cover a few large components and a long DAG of triangles that stalls
+// pivoting
+bool TestLargeForwardBackward(std::ostream& out)
+{
+    using TGraph = Graph::CompressedSparseRowGraph<size_t, Graph::Edge<size_t>>;
+
+    try
+    {
+        // Four rings with chords, each ring linked to the next
+        const size_t ringSize = 5000;
+        std::vector<Graph::Edge<size_t>> giantEdges;
+        for (size_t ring = 0; ring < 4; ++ring)
+        {
+            size_t first = ring * ringSize;
+            for (size_t index = 0; index < ringSize; ++index)
+            {
+                giantEdges.emplace_back(first + index, first + (index + 1) % ringSize);
+                giantEdges.emplace_back(first + index, first + (index * 7 + 3) % ringSize);
+            }
+            if (ring > 0)
+            {
+                giantEdges.emplace_back(first - 1, first);
+            }
+        }
+        TGraph giant(4 * ringSize, giantEdges.begin(), giantEdges.end());
+
+        // Triangles, each pointing to one of the next fifty
+        const size_t triangleCount = 20000;
+        std::vector<Graph::Edge<size_t>> tinyEdges;
+        for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+        {
+            size_t first = 3 * triangle;
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                tinyEdges.emplace_back(first + corner, first + (corner + 1) % 3);
+            }
+            size_t later = triangle + 1 + triangle * 2654435761u % 50;
+            if (later < triangleCount)
+            {
+                tinyEdges.emplace_back(first + triangle % 3, 3 * later + later % 3);
+            }
+        }
+        TGraph tiny(3 * triangleCount, tinyEdges.begin(), tinyEdges.end());
+
+        for (const auto* graph : { &giant, &tiny })
+        {
+            Graph::StronglyConnectedComponentAlgorithm<TGraph> algo(*graph);
+            algo.Compute();
+            Graph::ForwardBackwardStronglyConnectedComponentAlgorithm<TGraph> parallelAlgo(
+                *graph, 4);
+            parallelAlgo.Compute();
+            if (parallelAlgo.GetComponentsCount() != algo.GetComponentsCount() ||
+                !HaveSameComponents(*graph, algo.GetComponents(), parallelAlgo.GetComponents()))
+            {
+                throw std::logic_error(
+                    "forward-backward decomposition found different components");
+            }
+        }
+        Graph::ForwardBackwardStronglyConnectedComponentAlgorithm<TGraph> tinyAlgo(tiny, 4);
+        tinyAlgo.Compute();
+        if (tinyAlgo.GetComponentsCount() != triangleCount)
+        {
+            throw std::logic_error("forward-backward decomposition merged triangles");
+        }
+    }
+    catch (const std::exception& exc)
+    {
+        out << "Test failed. Reason: " << exc.what() << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+// The random graphs above are far below TrimAlgorithm's parallel grain.
+// Here a wide layered DAG, trimmed level by level with frontiers of
+// thousands of vertices, sits next to planted components that survive
+// trimming; the parallel trim must agree with the serial one and with
+// plain Tarjan.
+bool TestLargeTrimming(std::ostream& out)
+{
+    using TGraph = Graph::CompressedSparseRowGraph<uint32_t, Graph::Edge<uint32_t>>;
+
+    try
+    {
+        auto planted = Graph::GraphGenerator<uint32_t>(11)
+            .PlantedComponents(200, 20, 2000, 4000);
+        auto dag = Graph::GraphGenerator<uint32_t>(12).LayeredDag(6, 2000, 30000);
+        std::vector<Graph::Edge<uint32_t>> edges(planted.edges.begin(), planted.edges.end());
+        for (const auto& edge : dag.edges)
+        {
+            edges.emplace_back(uint32_t(planted.vertexCount + edge.Source()),
+                uint32_t(planted.vertexCount + edge.Target()));
+        }
+        TGraph graph(planted.vertexCount + dag.vertexCount, edges.begin(), edges.end());
+
+        Graph::StronglyConnectedComponentAlgorithm<TGraph> algo(graph);
+        algo.Compute();
+        Graph::TrimAlgorithm<TGraph, Graph::VectorPropertyMapSelector> serialTrim(graph);
+        serialTrim.Compute();
+        Graph::TrimAlgorithm<TGraph, Graph::VectorPropertyMapSelector> parallelTrim(graph, 4);
+        parallelTrim.Compute();
+        if (parallelTrim.GetComponentsCount() != serialTrim.GetComponentsCount() ||
+            parallelTrim.GetComponentsCount() < dag.vertexCount)
+        {
+            throw std::logic_error("parallel trimming peeled a different vertex set");
+        }
+        for (const auto& vertex : graph.Vertices())
+        {
+            if (parallelTrim.IsTrimmed(vertex) != serialTrim.IsTrimmed(vertex))
+            {
+                throw std::logic_error("parallel trimming peeled a different vertex set");
+            }
+        }
+
+        Graph::StronglyConnectedComponentAlgorithm<TGraph> trimmedAlgo(graph);
+        trimmedAlgo.SetTrimming(true, 4);
+        trimmedAlgo.Compute();
+        if (trimmedAlgo.GetComponentsCount() != algo.GetComponentsCount() ||
+            !HaveSameComponents(graph, algo.GetComponents(), trimmedAlgo.GetComponents()))
+        {
+            throw std::logic_error("components differ with parallel trimming");
+        }
+    }
+    catch (const std::exception& exc)
+    {
+        out << "Test failed. Reason: " << exc.what() << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+// Breaking a cycle of more than 2^17 vertices that has a component on
+// either side splits it into more pieces than two order gaps can hold, so
+// the renumbering has to make room in proportion to the split
+bool TestLargeDynamicSplit(std::ostream& out)
+{
+    using TGraph = Graph::AdjacencyGraph<int, Graph::Edge<int>>;
+
+    try
+    {
+        const int cycleLength = 140000;
+        std::vector<Graph::Edge<int>> edges;
+        for (int vertex = 0; vertex < cycleLength; ++vertex)
+        {
+            edges.emplace_back(vertex, (vertex + 1) % cycleLength);
+        }
+        edges.emplace_back(-1, 0);
+        edges.emplace_back(cycleLength - 1, cycleLength);
+        TGraph graph;
+        graph.AddVerticesAndEdgeRange(edges.begin(), edges.end());
+
+        Graph::DynamicStronglyConnectedComponents<TGraph> dynamic(graph);
+        graph.RemoveEdge(Graph::Edge<int>(cycleLength - 1, 0));
+        if (dynamic.GetComponentsCount() != size_t(cycleLength) + 2)
+        {
+            throw std::logic_error("broken cycle was not split into single vertices");
+        }
+        CheckDynamicComponents(graph, dynamic);
+    }
+    catch (const std::exception& exc)
+    {
+        out << "Test failed. Reason: " << exc.what() << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+// A graph using every value of its descriptor type has VertexCount() one
+// past the largest descriptor; vertex ranges must still cover all of it
+bool TestFullDescriptorRange(std::ostream& out)
+{
+    using TNarrowGraph = Graph::CompressedSparseRowGraph<uint16_t, Graph::Edge<uint16_t>>;
+    using TWideGraph = Graph::CompressedSparseRowGraph<uint32_t, Graph::Edge<uint32_t>>;
+
+    std::string path = GetTemporaryPath("scc_tester_full_range.bin");
+    try
+    {
+        auto generated = Graph::GraphGenerator<uint16_t>(5).Rmat(16, 200000);
+        TNarrowGraph narrow = generated.ToCompressedSparseRowGraph();
+        std::vector<Graph::Edge<uint32_t>> wideEdges;
+        for (const auto& edge : generated.edges)
+        {
+            wideEdges.emplace_back(edge.Source(), edge.Target());
+        }
+        TWideGraph wide(generated.vertexCount, wideEdges.begin(), wideEdges.end());
+        if (narrow.VertexCount() != 65536 || Graph::VertexIndexBound(narrow) != 65536)
+        {
+            throw std::logic_error("full descriptor range enumerates the wrong vertices");
+        }
+
+        Graph::StronglyConnectedComponentAlgorithm<TWideGraph> wideAlgo(wide);
+        wideAlgo.Compute();
+        auto check = [&wide, &wideAlgo](const char* name, size_t componentsCount,
+            const std::vector<size_t>& components)
+        {
+            if (componentsCount != wideAlgo.GetComponentsCount() ||
+                !HaveSameComponents(wide, wideAlgo.GetComponents(), components))
+            {
+                throw std::logic_error(std::string("components differ on full range ") + name);
+            }
+        };
+        auto collect = [&narrow](const auto& components)
+        {
+            std::vector<size_t> result;
+            for (const auto& vertex : narrow.Vertices())
+            {
+                result.push_back(components[vertex]);
+            }
+            return result;
+        };
+
+        Graph::StronglyConnectedComponentAlgorithm<TNarrowGraph> narrowAlgo(narrow);
+        narrowAlgo.Compute();
+        check("compressed sparse row graph", narrowAlgo.GetComponentsCount(),
+            collect(narrowAlgo.GetComponents()));
+
+        auto delta = Graph::DeltaCompressedGraph<uint16_t, Graph::Edge<uint16_t>>(narrow);
+        Graph::StronglyConnectedComponentAlgorithm<decltype(delta)> deltaAlgo(delta);
+        deltaAlgo.Compute();
+        check("delta-compressed graph", deltaAlgo.GetComponentsCount(),
+            collect(deltaAlgo.GetComponents()));
+
+        Graph::WriteBinaryGraph(narrow, path);
+        Graph::MappedGraph<uint16_t, Graph::Edge<uint16_t>> mapped(path);
+        mapped.Validate();
+        Graph::StronglyConnectedComponentAlgorithm<decltype(mapped)> mappedAlgo(mapped);
+        mappedAlgo.Compute();
+        check("memory-mapped graph", mappedAlgo.GetComponentsCount(),
+            collect(mappedAlgo.GetComponents()));
+    }
+    catch (const std::exception& exc)
+    {
+        std::remove(path.c_str());
+        out << "Test failed. Reason: " << exc.what() << '\n';
+        return false;
+    }
+    std::remove(path.c_str());
+    out << "Test passed\n";
+    return true;
+}
+
+// Batched results must match one algorithm per graph, id for id, also when
+// the workspaces come back from a batch of larger graphs
+bool TestBatch(std::ostream& out)
+{
+    try
+    {
+        using TGraph = Graph::CompressedSparseRowGraph<uint32_t, Graph::Edge<uint32_t>>;
+        Graph::BatchStronglyConnectedComponents<TGraph> batch(4);
+        for (size_t maxVertexCount : { 200, 40 })
+        {
+            std::vector<TGraph> graphs;
+            for (uint64_t seed = 0; seed < 300; ++seed)
+            {
+                size_t vertexCount = GetRandomValue<size_t>(1, maxVertexCount);
+                size_t edgesCount = GetRandomValue<size_t>(0, 2 * vertexCount);
+                graphs.push_back(Graph::GraphGenerator<uint32_t>(seed)
+                    .ErdosRenyi(vertexCount, edgesCount).ToCompressedSparseRowGraph());
+            }
+            batch.Compute(graphs);
+            if (batch.GraphCount() != graphs.size() ||
+                batch.GetOffsets().back() != batch.GetComponents().size())
+            {
+                throw std::logic_error("batch result buffer has the wrong shape");
+            }
+            for (size_t index = 0; index < graphs.size(); ++index)
+            {
+                Graph::StronglyConnectedComponentAlgorithm<TGraph> algo(graphs[index]);
+                algo.Compute();
+                if (batch.GetComponentsCount(index) != algo.GetComponentsCount())
+                {
+                    throw std::logic_error("batch found a different component count");
+                }
+                auto component = batch.GetComponents(index).begin();
+                for (const auto& vertex : graphs[index].Vertices())
+                {
+                    if (*component++ != algo.GetComponents()[vertex])
+                    {
+                        throw std::logic_error("batch numbered components differently");
+                    }
+                }
+            }
+        }
+    }
+    catch (const std::exception& exc)
+    {
+        out << "Test failed. Reason: " << exc.what() << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+template <typename TFunc>
+bool Throws(TFunc func)
+{
+    try
+    {
+        func();
+    }
+    catch (const std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+}
+
+// Rewrites one field of a valid binary graph file at the given byte offset
+template <typename TValue>
+void PatchFile(const std::string& path, size_t offset, TValue value)
+{
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    if (!file)
+    {
+        throw std::logic_error("cannot patch '" + path + "'");
+    }
+}
+
+// A header whose sizes wrap around or whose last offset disagrees with it
+// must be refused on open; a bad offset or target in between by Validate()
+// and by the semi-external scan
+bool TestCorruptBinaryGraph(std::ostream& out)
+{
+    using TMappedGraph = Graph::MappedGraph<int, Graph::Edge<int>>;
+    using TSemiExternal = Graph::SemiExternalStronglyConnectedComponentAlgorithm<int>;
+    std::string path = GetTemporaryPath("scc_tester_corrupt.bin");
+    try
+    {
+        const size_t vertexCount = 50;
+        const size_t offsetsStart = sizeof(Graph::BinaryGraphHeader);
+        const size_t targetsStart = offsetsStart + (vertexCount + 1) * sizeof(uint64_t);
+        auto graph = Graph::GraphGenerator<int>(7).ErdosRenyi(vertexCount, 200)
+            .ToCompressedSparseRowGraph();
+        auto write = [&path, &graph]()
+        {
+            Graph::WriteBinaryGraph(graph, path);
+        };
+        const uint64_t edgeCount = graph.EdgeCount();
+
+        write();
+        TMappedGraph(path).Validate();
+
+        // 2^62 more targets of 4 bytes wrap the size back to that of the file
+        uint64_t wrappingEdgeCount = edgeCount + (uint64_t(1) << 62);
+        PatchFile(path, offsetof(Graph::BinaryGraphHeader, edgeCount), wrappingEdgeCount);
+        if (!Throws([&path]() { TMappedGraph graph(path); }))
+        {
+            throw std::logic_error("overflowing edge count was accepted");
+        }
+
+        write();
+        PatchFile(path, offsetsStart + vertexCount * sizeof(uint64_t), edgeCount - 1);
+        if (!Throws([&path]() { TMappedGraph graph(path); }))
+        {
+            throw std::logic_error("last offset below the edge count was accepted");
+        }
+
+        write();
+        PatchFile(path, offsetsStart + 10 * sizeof(uint64_t), edgeCount + 1);
+        TMappedGraph unordered(path);
+        if (!Throws([&unordered]() { unordered.Validate(); }) ||
+            !Throws([&path]() { TSemiExternal(path, size_t(1) << 20).Compute(); }))
+        {
+            throw std::logic_error("decreasing offsets were accepted");
+        }
+
+        write();
+        for (int target : { int(vertexCount), -1 })
+        {
+            PatchFile(path, targetsStart + 17 * sizeof(int), target);
+            TMappedGraph outOfRange(path);
+            if (!Throws([&outOfRange]() { outOfRange.Validate(); }) ||
+                !Throws([&path]() { TSemiExternal(path, size_t(1) << 20).Compute(); }))
+            {
+                throw std::logic_error("target outside the vertex range was accepted");
+            }
+        }
+    }
+    catch (const std::exception& exc)
+    {
+        std::remove(path.c_str());
+        out << "Test failed. Reason: " << exc.what() << '\n';
+        return false;
+    }
+    std::remove(path.c_str());
+    out << "Test passed\n";
+    return true;
+}
+
+// Vertex ids that do not fit the descriptor are errors, also where the
+// decimal value exceeds 64 bits and would wrap around
+bool TestEdgeListLimits(std::ostream& out)
+{
+    try
+    {
+        auto parse = [](const std::string& text)
+        {
+            return Graph::EdgeListReader<uint64_t>(2, 16).Parse(
+                text.data(), text.data() + text.size());
+        };
+        if (parse("0 1\n2 0\n").EdgeCount() != 2)
+        {
+            throw std::logic_error("edge list was parsed wrongly");
+        }
+        for (const char* text : { "0 18446744073709551616\n",
+            "184467440737095516150 1\n", "3 99999999999999999999999\n" })
+        {
+            if (!Throws([&parse, text]() { parse(text); }))
+            {
+                throw std::logic_error(std::string("oversized vertex id was accepted: ") + text);
+            }
+        }
+        // The largest descriptor itself is fine, and the search reaches it;
+        // one more is not
+        std::string largest = "65535 0\n0 65535\n";
+        auto largestGraph = Graph::EdgeListReader<uint16_t>(1, 16).Parse(
+            largest.data(), largest.data() + largest.size());
+        if (largestGraph.VertexCount() != 65536)
+        {
+            throw std::logic_error("largest vertex id was rejected");
+        }
+        Graph::StronglyConnectedComponentAlgorithm<decltype(largestGraph)> largestAlgo(
+            largestGraph);
+        largestAlgo.Compute();
+        // 0 and 65535 form a cycle, the other 65534 vertices are isolated
+        const auto& largestComponents = largestAlgo.GetComponents();
+        if (largestAlgo.GetComponentsCount() != 65535 ||
+            largestComponents[65535] != largestComponents[0] ||
+            largestComponents[65535] >= largestAlgo.GetComponentsCount())
+        {
+            throw std::logic_error("vertex with the largest id was not searched");
+        }
+        if (!Throws([]()
+            {
+                std::string text = "65536 0\n";
+                Graph::EdgeListReader<uint16_t>(1, 16).Parse(
+                    text.data(), text.data() + text.size());
+            }))
+        {
+            throw std::logic_error("vertex id above the descriptor range was accepted");
+        }
+    }
+    catch (const std::exception& exc)
+    {
+        out << "Test failed. Reason: " << exc.what() << '\n';
+        return false;
+    }
+    out << "Test passed\n";
+    return true;
+}
+
+// Semi-external results must match Tarjan whether the edges fit the memory
+// budget or not. On a chain of planted components whose cross edges run
+// against the id order, coloring settles one component per round, so a
+// budget that holds no edges takes exactly one round per component and a
+// budget for a quarter of them still takes several rounds before it can
+// finish in memory.
+bool TestSemiExternal(std::ostream& out)
+{
+    using TSemiExternal = Graph::SemiExternalStronglyConnectedComponentAlgorithm<uint32_t>;
+    using TGraph = Graph::CompressedSparseRowGraph<uint32_t, Graph::Edge<uint32_t>>;
+
+    const size_t blockBytes = 64;
+    const size_t stateBytesPerVertex = sizeof(uint32_t) + sizeof(size_t);
+    std::string path = GetTemporaryPath("scc_tester_semi_external.bin");
+    try
+    {
+        // Every pass streams both sections once
+        auto checkAgainstTarjan = [](const TGraph& graph, TSemiExternal& semiExternal)
+        {
+            semiExternal.SetBlockBytes(blockBytes);
+            semiExternal.Compute();
+            Graph::StronglyConnectedComponentAlgorithm<TGraph> algo(graph);
+            algo.Compute();
+            uint64_t passBytes = (graph.VertexCount() + 1) * sizeof(uint64_t) +
+                graph.EdgeCount() * sizeof(uint32_t);
+            if (semiExternal.GetBytesRead() != sizeof(Graph::BinaryGraphHeader) +
+                semiExternal.GetPassCount() * passBytes)
+            {
+                throw std::logic_error("semi-external pass count disagrees with bytes read");
+            }
+            if (semiExternal.GetComponentsCount() != algo.GetComponentsCount() ||
+                !HaveSameComponents(graph, algo.GetComponents(), semiExternal.GetComponents()))
+            {
+                throw std::logic_error("components differ on semi-external graph");
+            }
+        };
+
+        for (uint64_t seed = 0; seed < 10; ++seed)
+        {
+            size_t vertexCount = GetRandomValue<size_t>(1, 100);
+            size_t edgesCount = GetRandomValue<size_t>(0, 3 * vertexCount);
+            TGraph graph = Graph::GraphGenerator<uint32_t>(seed)
+                .ErdosRenyi(vertexCount, edgesCount).ToCompressedSparseRowGraph();
+            Graph::WriteBinaryGraph(graph, path);
+            size_t stateBytes = vertexCount * stateBytesPerVertex;
+            for (size_t edgeBudget : { size_t(0), size_t(1) << 20 })
+            {
+                TSemiExternal semiExternal(path, stateBytes + 2 * blockBytes + edgeBudget);
+                checkAgainstTarjan(graph, semiExternal);
+            }
+
+            TSemiExternal semiExternal(path, stateBytes + 2 * blockBytes);
+            semiExternal.SetBlockBytes(blockBytes);
+            semiExternal.SetReadBudget(sizeof(Graph::BinaryGraphHeader) + 8);
+            if (!Throws([&semiExternal]() { semiExternal.Compute(); }))
+            {
+                throw std::logic_error("semi-external read budget was not enforced");
+            }
+        }
+
+        const size_t componentCount = 30;
+        const size_t componentSize = 40;
+        auto planted = Graph::GraphGenerator<uint32_t>(21)
+            .PlantedComponents(componentCount, componentSize, 400, 0);
+        for (size_t component = 1; component < componentCount; ++component)
+        {
+            planted.edges.emplace_back(uint32_t(component * componentSize + 5),
+                uint32_t((component - 1) * componentSize + 17));
+        }
+        TGraph chain = planted.ToCompressedSparseRowGraph();
+        Graph::WriteBinaryGraph(chain, path);
+        size_t stateBytes = chain.VertexCount() * stateBytesPerVertex;
+
+        TSemiExternal outOfCore(path, stateBytes + 2 * blockBytes);
+        checkAgainstTarjan(chain, outOfCore);
+        // At least one propagation and one settling pass per round
+        if (outOfCore.GetRoundCount() != componentCount ||
+            outOfCore.GetPassCount() < 2 * componentCount)
+        {
+            throw std::logic_error("semi-external run took unexpected rounds");
+        }
+
+        // Edge list and CSR targets per edge, offsets and Tarjan's maps per
+        // vertex, as SemiExternalStronglyConnectedComponentAlgorithm sizes them
+        size_t residualBytes = chain.EdgeCount() * 3 * sizeof(size_t) +
+            chain.VertexCount() * 8 * sizeof(size_t);
+        TSemiExternal partlyInMemory(path, stateBytes + 2 * blockBytes + residualBytes / 4);
+        checkAgainstTarjan(chain, partlyInMemory);
+        if (partlyInMemory.GetRoundCount() < 2 ||
+            partlyInMemory.GetRoundCount() >= componentCount ||
+            partlyInMemory.GetPassCount() >= outOfCore.GetPassCount())
+        {
+            throw std::logic_error("semi-external run did not finish in memory after a few rounds");
+        }
+    }
+    catch (const std::exception& exc)
+    {
+        std::remove(path.c_str());
+        out << "Test failed. Reason: " << exc.what() << '\n';
+        return false;
+    }
+    std::remove(path.c_str());
+    out << "Test passed\n";
+    return true;
+}
+
 
 int main()
 {
     for (int attempt = 0; attempt < 10; ++attempt)
     {
-        if(!RunTest(std::cout, GetRandomGraph<int>()))
+        if(!RunTest(std::cout, GetRandomGraph<int>(attempt)))
         {
             return 1;
         }
     }
+    if (!TestGenerators(std::cout))
+    {
+        return 1;
+    }
+    if (!TestLargeForwardBackward(std::cout))
+    {
+        return 1;
+    }
+    if (!TestLargeTrimming(std::cout))
+    {
+        return 1;
+    }
+    if (!TestLargeDynamicSplit(std::cout))
+    {
+        return 1;
+    }
+    if (!TestFullDescriptorRange(std::cout))
+    {
+        return 1;
+    }
+    if (!TestBatch(std::cout))
+    {
+        return 1;
+    }
+    if (!TestCorruptBinaryGraph(std::cout))
+    {
+        return 1;
+    }
+    if (!TestEdgeListLimits(std::cout))
+    {
+        return 1;
+    }
+    if (!TestSemiExternal(std::cout))
+    {
+        return 1;
+    }
     return 0;
 }